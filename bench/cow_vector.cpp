@@ -0,0 +1,77 @@
+#include "vector.hpp"
+#include "cow_vector.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Copy-on-write vector                                                      //
+// -------------------------------------------------------------------------- //
+// Copies of a vector of n strings passed by value to a reader that sums a
+// few of their lengths, as a configuration reload hands its tables around.
+// ft::vector copies every element, ft::cow_vector shares its buffer. A last
+// column has every tenth copy modified once, which detaches it.
+//
+// Usage: ./bench/cow_vector [copies]
+
+typedef std::chrono::steady_clock	bench_clock;
+
+static std::size_t	sink = 0;	// Keeps the copies from being optimized out
+
+template <class Vector>
+static std::size_t	read(const Vector v)
+{
+	return v.size() + v[0].size() + v[v.size() / 2].size() + v[v.size() - 1].size();
+}
+
+template <class Vector>
+static std::size_t	readAndWrite(Vector v, std::size_t i)
+{
+	if (i % 10 == 0)
+		v.push_back("modified");
+	return read<const Vector &>(v);
+}
+
+template <class Vector>
+static double	measure(const Vector &source, std::size_t copies, bool write)
+{
+	bench_clock::time_point	start = bench_clock::now();
+	std::size_t				sum = 0;
+
+	for (std::size_t i = 0; i < copies; ++i)
+		sum += write ? readAndWrite<Vector>(source, i) : read<Vector>(source);
+	sink += sum;
+	return std::chrono::duration<double, std::micro>(bench_clock::now() - start).count() / copies;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t			copies = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000;
+	const std::size_t	sizes[] = { 16, 1000, 100000 };
+
+	if (copies == 0)
+		copies = 1;
+	std::cout << copies << " copies, us per copy" << std::endl;
+	std::cout << std::setw(9) << "size" << std::setw(11) << "vector" << std::setw(11) << "cow"
+		<< std::setw(14) << "cow 10% mod" << std::endl;
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		ft::vector<std::string>		plain;
+
+		for (std::size_t i = 0; i < sizes[s]; ++i)
+			plain.push_back(std::string(24, static_cast<char>('a' + i % 26)));
+
+		const ft::cow_vector<std::string>	shared(plain);
+		double								plainUs = measure(plain, copies, false);
+		double								cowUs = measure(shared, copies, false);
+		double								cowWriteUs = measure(shared, copies, true);
+
+		std::cout << std::setw(9) << sizes[s] << std::fixed << std::setprecision(3)
+			<< std::setw(11) << plainUs << std::setw(11) << cowUs << std::setw(14) << cowWriteUs << std::endl;
+	}
+	std::cout << "(" << (sink & 0xff) << ")" << std::endl;
+	return 0;
+}
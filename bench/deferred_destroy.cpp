@@ -0,0 +1,75 @@
+#include "map.hpp"
+#include "vector.hpp"
+#include "deferred_destroy.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Deferred destruction                                                      //
+// -------------------------------------------------------------------------- //
+// Time the thread dropping a container spends on it: a ft::map<int, int> and
+// a ft::vector<std::string> of n elements going out of scope, against
+// ft::deferred_destroy handing them to the reclaimer thread. Each drop is
+// followed by deferred_flush(), outside of the measure, so that the next
+// one starts with an idle reclaimer; the first one also starts its thread.
+//
+// Usage: ./bench/deferred_destroy [max size]
+
+typedef std::chrono::steady_clock	bench_clock;
+
+static double	elapsedMs(bench_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+template <class Container>
+static void	report(const char *name, std::size_t n, Container &inline_, Container &deferred)
+{
+	bench_clock::time_point	start = bench_clock::now();
+
+	{
+		Container	dropped;
+
+		dropped.swap(inline_);
+	}
+
+	double	inlineMs = elapsedMs(start);
+
+	start = bench_clock::now();
+	ft::deferred_destroy(deferred);
+
+	double	deferredMs = elapsedMs(start);
+
+	ft::deferred_flush();
+	std::cout << std::setw(8) << name << std::setw(10) << n << std::fixed << std::setprecision(3)
+		<< std::setw(12) << inlineMs << std::setw(12) << deferredMs << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t	maxSize = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 4000000;
+
+	std::cout << "ms spent by the dropping thread" << std::endl;
+	std::cout << std::setw(8) << "type" << std::setw(10) << "size" << std::setw(12) << "inline"
+		<< std::setw(12) << "deferred" << std::endl;
+	for (std::size_t n = 1000; n <= maxSize; n *= 10)
+	{
+		ft::map<int, int>			mapInline, mapDeferred;
+		ft::vector<std::string>		vectorInline, vectorDeferred;
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			mapInline[static_cast<int>(i)] = static_cast<int>(i);
+			mapDeferred[static_cast<int>(i)] = static_cast<int>(i);
+			vectorInline.push_back(std::string(32, 'x'));
+			vectorDeferred.push_back(std::string(32, 'x'));
+		}
+		report("map", n, mapInline, mapDeferred);
+		report("vector", n, vectorInline, vectorDeferred);
+	}
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "map.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Batched lookups                                                           //
+// -------------------------------------------------------------------------- //
+// Looks up requests of k random present keys in a ft::map of n 64-bit keys,
+// either with one find() per key or with a single find_batch() per request.
+// Small maps fit in cache, where there is little latency left to hide.
+//
+// Usage: ./bench/find_batch [lookups]
+
+typedef std::chrono::steady_clock				bench_clock;
+typedef unsigned long long						bench_key;
+typedef ft::map<bench_key, bench_key>			map_type;
+
+static bench_key	nextRandom(bench_key &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static bench_key	sink = 0;	// Keeps the lookups from being optimized out
+
+// Runs requests of batch keys taken in turn from keys, in nanoseconds per key
+static double	measure(const map_type &m, const std::vector<bench_key> &keys, std::size_t batch,
+	std::size_t lookups, bool batched)
+{
+	std::vector<map_type::const_iterator>	found(batch);
+	bench_clock::time_point					start = bench_clock::now();
+	bench_key								sum = 0;
+	std::size_t								done = 0;
+
+	for (std::size_t offset = 0; done < lookups; done += batch)
+	{
+		const bench_key	*request = &keys[offset];
+
+		if (batched)
+			m.find_batch(request, request + batch, found.begin());
+		else
+			for (std::size_t i = 0; i < batch; ++i)
+				found[i] = m.find(request[i]);
+		for (std::size_t i = 0; i < batch; ++i)
+			sum += found[i]->second;
+		offset += batch;
+		if (offset + batch > keys.size())
+			offset = 0;
+	}
+	sink += sum;
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / done;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t			lookups = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000000;
+	const std::size_t	sizes[] = { 1000, 100000, 1000000, 4000000 };
+	const std::size_t	batches[] = { 32, 256 };
+
+	if (lookups == 0)
+		lookups = 1;
+	std::cout << lookups << " lookups, ns per key" << std::endl;
+	std::cout << std::setw(9) << "size" << std::setw(7) << "batch" << std::setw(11) << "find"
+		<< std::setw(13) << "find_batch" << std::endl;
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		bench_key				state = 88172645463325252ULL;
+		map_type				m;
+		std::vector<bench_key>	keys;
+
+		for (std::size_t i = 0; i < sizes[s]; ++i)
+		{
+			bench_key	key = nextRandom(state);
+
+			m.insert(ft::make_pair(key, i));
+			keys.push_back(key);
+		}
+		for (std::size_t i = keys.size(); i > 1; --i)
+			std::swap(keys[i - 1], keys[nextRandom(state) % i]);
+		while (keys.size() < 256)
+			keys.insert(keys.end(), keys.begin(), keys.end());
+
+		for (std::size_t b = 0; b < sizeof(batches) / sizeof(*batches); ++b)
+		{
+			double	single = measure(m, keys, batches[b], lookups, false);
+			double	batched = measure(m, keys, batches[b], lookups, true);
+
+			std::cout << std::setw(9) << sizes[s] << std::setw(7) << batches[b] << std::fixed << std::setprecision(1)
+				<< std::setw(11) << single << std::setw(13) << batched
+				<< "   x" << std::setprecision(2) << single / batched << std::endl;
+		}
+	}
+	std::cout << "(" << (sink & 0xff) << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include "map.hpp"
+#include "frozen_map.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Frozen map                                                                //
+// -------------------------------------------------------------------------- //
+// Random lookups of present 64-bit keys with at(), after the containers were
+// filled, on:
+//   - std::map and ft::map (red-black trees),
+//   - a sorted std::vector searched with std::lower_bound,
+//   - the ft::frozen_map given by ft::map::freeze() (Eytzinger layout).
+// Sizes go from cache resident to well past the last level cache.
+//
+// Usage: ./bench/frozen_map [lookups]
+
+typedef std::chrono::steady_clock	bench_clock;
+typedef unsigned long long			bench_key;
+
+static bench_key	nextRandom(bench_key &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static bench_key	sink = 0;	// Keeps the lookups from being optimized out
+
+// Looks up keys[i % keys.size()] for every i, in nanoseconds per lookup
+template <class Lookup>
+static double	measure(Lookup lookup, const std::vector<bench_key> &keys, std::size_t lookups)
+{
+	bench_clock::time_point	start = bench_clock::now();
+	bench_key				sum = 0;
+
+	for (std::size_t i = 0; i < lookups; ++i)
+		sum += lookup(keys[i % keys.size()]);
+	sink += sum;
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / lookups;
+}
+
+template <class Map>
+struct map_at
+{
+	const Map	*m;
+
+	bench_key	operator()(bench_key key) const
+	{
+		return m->at(key);
+	}
+};
+
+struct sorted_at
+{
+	const std::vector<std::pair<bench_key, bench_key> >	*v;
+
+	bench_key	operator()(bench_key key) const
+	{
+		return std::lower_bound(v->begin(), v->end(), std::make_pair(key, 0ULL))->second;
+	}
+};
+
+static void	benchSize(std::size_t n, std::size_t lookups)
+{
+	bench_key												state = 88172645463325252ULL;
+	std::map<bench_key, bench_key>							stdMap;
+	ft::map<bench_key, bench_key>							ftMap;
+	std::vector<std::pair<bench_key, bench_key> >			sorted;
+	std::vector<bench_key>									keys;
+
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		bench_key	key = nextRandom(state);
+
+		stdMap.insert(std::make_pair(key, i));
+		ftMap.insert(ft::make_pair(key, i));
+		sorted.push_back(std::make_pair(key, i));
+		keys.push_back(key);
+	}
+	std::sort(sorted.begin(), sorted.end());
+	for (std::size_t i = keys.size(); i > 1; --i)
+		std::swap(keys[i - 1], keys[nextRandom(state) % i]);
+
+	ft::frozen_map<bench_key, bench_key>	frozen = ftMap.freeze();
+
+	map_at<std::map<bench_key, bench_key> >			stdAt = { &stdMap };
+	map_at<ft::map<bench_key, bench_key> >			ftAt = { &ftMap };
+	map_at<ft::frozen_map<bench_key, bench_key> >	frozenAt = { &frozen };
+	sorted_at										sortedAt = { &sorted };
+
+	double	stdNs = measure(stdAt, keys, lookups);
+	double	ftNs = measure(ftAt, keys, lookups);
+	double	sortedNs = measure(sortedAt, keys, lookups);
+	double	frozenNs = measure(frozenAt, keys, lookups);
+
+	std::cout << std::setw(9) << n << std::fixed << std::setprecision(1)
+		<< std::setw(11) << stdNs << std::setw(11) << ftNs
+		<< std::setw(11) << sortedNs << std::setw(11) << frozenNs
+		<< "   x" << std::setprecision(2) << ftNs / frozenNs << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t			lookups = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000000;
+	const std::size_t	sizes[] = { 1000, 32000, 1000000, 4000000 };
+
+	if (lookups == 0)
+		lookups = 1;
+	std::cout << lookups << " random lookups with at(), ns per lookup" << std::endl;
+	std::cout << std::setw(9) << "size" << std::setw(11) << "std::map" << std::setw(11) << "ft::map"
+		<< std::setw(11) << "sorted" << std::setw(11) << "frozen" << "   frozen vs ft::map" << std::endl;
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+		benchSize(sizes[i], lookups);
+	std::cout << "(" << (sink & 0xff) << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "map.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Key prefixes                                                              //
+// -------------------------------------------------------------------------- //
+// Random lookups with find() of present std::string keys, long enough to be
+// on the heap, in a ft::map storing the first 8 bytes of every key in its
+// nodes (the default with std::less) and in one ordered by an equivalent
+// comparator, for which nothing is stored. Keys either differ early, or
+// share a 16-byte prefix that the stored bytes cannot tell apart.
+//
+// Usage: ./bench/key_prefix [lookups]
+
+typedef std::chrono::steady_clock	bench_clock;
+typedef unsigned long long			bench_key;
+
+// Same order as std::less, but not recognized as such by the tree
+struct plain_less
+{
+	bool	operator()(const std::string &lhs, const std::string &rhs) const
+	{
+		return lhs < rhs;
+	}
+};
+
+typedef ft::map<std::string, bench_key>				prefix_map;
+typedef ft::map<std::string, bench_key, plain_less>	plain_map;
+
+static bench_key	nextRandom(bench_key &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static bench_key	sink = 0;	// Keeps the lookups from being optimized out
+
+template <class Map>
+static double	measure(const Map &m, const std::vector<std::string> &keys, std::size_t lookups)
+{
+	bench_clock::time_point	start = bench_clock::now();
+	bench_key				sum = 0;
+
+	for (std::size_t i = 0; i < lookups; ++i)
+		sum += m.find(keys[i % keys.size()])->second;
+	sink += sum;
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / lookups;
+}
+
+static void	benchSize(std::size_t n, std::size_t lookups, const char *format)
+{
+	bench_key					state = 88172645463325252ULL;
+	prefix_map					prefixed;
+	plain_map					plain;
+	std::vector<std::string>	keys;
+	char						buffer[64];
+
+	while (keys.size() < n)
+	{
+		bench_key	r = nextRandom(state);
+
+		std::snprintf(buffer, sizeof(buffer), format, r);
+		if (!prefixed.insert(ft::make_pair(std::string(buffer), r)).second)
+			continue ;
+		plain.insert(ft::make_pair(std::string(buffer), r));
+		keys.push_back(buffer);
+	}
+	for (std::size_t i = keys.size(); i > 1; --i)
+		std::swap(keys[i - 1], keys[nextRandom(state) % i]);
+
+	double	plainNs = measure(plain, keys, lookups);
+	double	prefixNs = measure(prefixed, keys, lookups);
+
+	std::cout << std::setw(9) << n << std::setw(22) << format << std::fixed << std::setprecision(1)
+		<< std::setw(11) << plainNs << std::setw(11) << prefixNs
+		<< "   x" << std::setprecision(2) << plainNs / prefixNs << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t			lookups = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000000;
+	const std::size_t	sizes[] = { 1000, 100000, 1000000 };
+	const char			*formats[] = { "%016llx:user", "session:user:%016llx" };
+
+	if (lookups == 0)
+		lookups = 1;
+	std::cout << lookups << " random lookups with find(), ns per lookup" << std::endl;
+	std::cout << std::setw(9) << "size" << std::setw(22) << "keys" << std::setw(11) << "plain"
+		<< std::setw(11) << "prefix" << std::endl;
+	for (std::size_t f = 0; f < sizeof(formats) / sizeof(*formats); ++f)
+		for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+			benchSize(sizes[i], lookups, formats[f]);
+	std::cout << "(" << (sink & 0xff) << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,79 @@
+#include "map.hpp"
+#include "node_cache_allocator.hpp"
+
+#include <pthread.h>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Node caches                                                               //
+// -------------------------------------------------------------------------- //
+// Threads building and destroying their own ft::map<int, int> of 10000
+// elements over and over, with std::allocator and with
+// ft::node_cache_allocator. Every node allocation of the first reaches the
+// global heap; with the second, threads only meet at the depot once per
+// magazine. The gap grows with the number of threads and of cores.
+//
+// Usage: ./bench/node_cache [max threads]
+
+typedef std::chrono::steady_clock																	bench_clock;
+typedef ft::map<int, int>																			heap_map;
+typedef ft::map<int, int, std::less<int>, ft::node_cache_allocator<ft::pair<const int, int> > >	cached_map;
+
+static const int	elements = 10000;
+static const int	rounds = 40;
+
+template <class Map>
+static void	*churn(void *arg)
+{
+	unsigned long	*sum = static_cast<unsigned long *>(arg);
+
+	for (int round = 0; round < rounds; ++round)
+	{
+		Map	m;
+
+		for (int i = 0; i < elements; ++i)
+			m[(i * 7919) % elements] = i;
+		*sum += m.size();
+	}
+	return NULL;
+}
+
+// Nanoseconds per node, allocation and deallocation included
+template <class Map>
+static double	measure(std::size_t threads)
+{
+	pthread_t				workers[64];
+	unsigned long			sums[64] = { 0 };
+	bench_clock::time_point	start = bench_clock::now();
+
+	for (std::size_t i = 0; i < threads; ++i)
+		pthread_create(&workers[i], NULL, &churn<Map>, &sums[i]);
+	for (std::size_t i = 0; i < threads; ++i)
+		pthread_join(workers[i], NULL);
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count()
+		/ (static_cast<double>(threads) * rounds * elements);
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t	maxThreads = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 64;
+
+	if (maxThreads == 0 || maxThreads > 64)
+		maxThreads = 64;
+	std::cout << "ns per inserted and freed node, all threads together" << std::endl;
+	std::cout << std::setw(8) << "threads" << std::setw(11) << "heap" << std::setw(11) << "cached" << std::endl;
+	for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		double	heapNs = measure<heap_map>(threads);
+		double	cachedNs = measure<cached_map>(threads);
+
+		std::cout << std::setw(8) << threads << std::fixed << std::setprecision(1)
+			<< std::setw(11) << heapNs << std::setw(11) << cachedNs
+			<< "   x" << std::setprecision(2) << heapNs / cachedNs << std::endl;
+	}
+	return 0;
+}
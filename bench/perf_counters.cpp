@@ -0,0 +1,356 @@
+#include "map.hpp"
+#include "vector.hpp"
+#include "stack.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <stack>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------------- //
+//  Hardware performance counters                                             //
+// -------------------------------------------------------------------------- //
+// Runs the same workloads on the ft and std containers, reading hardware
+// counters with perf_event_open around each of them, and prints time and
+// counters per operation. Only user space is counted. Counters the kernel
+// or the machine do not provide (virtual machines, containers,
+// perf_event_paranoid > 2) are shown as "-", down to a time only report.
+//
+// Usage: ./bench/perf_counters [n]
+
+typedef std::chrono::steady_clock	bench_clock;
+typedef unsigned long long			bench_key;
+
+// --- Counter set --- //
+struct counter_event
+{
+	const char		*name;
+	unsigned int	type;
+	unsigned long	config;
+};
+
+#ifdef __linux__
+# define FT_HW_CACHE(cache, op, result)	((cache) | ((op) << 8) | ((result) << 16))
+
+static const counter_event	events[] = {
+	{ "instr", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ "L1d-miss", PERF_TYPE_HW_CACHE, FT_HW_CACHE(PERF_COUNT_HW_CACHE_L1D,
+		PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+	{ "LLC-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	{ "br-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+	{ "dTLB-miss", PERF_TYPE_HW_CACHE, FT_HW_CACHE(PERF_COUNT_HW_CACHE_DTLB,
+		PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+};
+#else
+static const counter_event	events[] = {
+	{ "instr", 0, 0 },
+	{ "cycles", 0, 0 },
+	{ "L1d-miss", 0, 0 },
+	{ "LLC-miss", 0, 0 },
+	{ "br-miss", 0, 0 },
+	{ "dTLB-miss", 0, 0 },
+};
+#endif
+
+static const std::size_t	eventCount = sizeof(events) / sizeof(*events);
+
+// Every event is opened on its own rather than as a group, so that a
+// missing one does not take the others down. When the kernel multiplexes
+// them, counts are scaled by the share of time they actually ran.
+class perf_counters
+{
+	private:
+		int		_fds[eventCount];
+
+		perf_counters(const perf_counters &);
+		perf_counters	&operator=(const perf_counters &);
+
+	public:
+		perf_counters()
+		{
+			for (std::size_t i = 0; i < eventCount; ++i)
+				_fds[i] = open(events[i]);
+		}
+
+		~perf_counters()
+		{
+#ifdef __linux__
+			for (std::size_t i = 0; i < eventCount; ++i)
+				if (_fds[i] != -1)
+					close(_fds[i]);
+#endif
+		}
+
+		bool	available(std::size_t i) const
+		{
+			return _fds[i] != -1;
+		}
+
+		bool	anyAvailable(void) const
+		{
+			for (std::size_t i = 0; i < eventCount; ++i)
+				if (available(i))
+					return true;
+			return false;
+		}
+
+		void	start(void)
+		{
+#ifdef __linux__
+			for (std::size_t i = 0; i < eventCount; ++i)
+			{
+				if (!available(i))
+					continue ;
+				ioctl(_fds[i], PERF_EVENT_IOC_RESET, 0);
+				ioctl(_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		void	stop(void)
+		{
+#ifdef __linux__
+			for (std::size_t i = 0; i < eventCount; ++i)
+				if (available(i))
+					ioctl(_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+#endif
+		}
+
+		// Scaled count since start(), -1 when the event is unavailable
+		double	read(std::size_t i) const
+		{
+#ifdef __linux__
+			unsigned long long	values[3];	// value, time enabled, time running
+
+			if (!available(i) || ::read(_fds[i], values, sizeof(values)) != sizeof(values))
+				return -1;
+			if (values[2] == 0)
+				return 0;
+			return static_cast<double>(values[0]) * values[1] / values[2];
+#else
+			(void)i;
+			return -1;
+#endif
+		}
+
+	private:
+		static int	open(const counter_event &event)
+		{
+#ifdef __linux__
+			perf_event_attr	attr;
+
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = event.type;
+			attr.config = event.config;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+			(void)event;
+			return -1;
+#endif
+		}
+};
+
+// --- Measurement --- //
+static bench_key	nextRandom(bench_key &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static bench_key	sink = 0;	// Keeps the workloads from being optimized out
+
+static void	printHeader(const perf_counters &counters)
+{
+	std::cout << std::left << std::setw(28) << "workload" << std::right << std::setw(10) << "ns/op";
+	for (std::size_t i = 0; i < eventCount; ++i)
+		std::cout << std::setw(11) << events[i].name;
+	std::cout << std::endl;
+	if (!counters.anyAvailable())
+		std::cout << "(hardware counters unavailable, time only)" << std::endl;
+}
+
+// Runs workload(operations) once with the counters around it
+template <class Workload>
+static void	measure(perf_counters &counters, const std::string &name, Workload workload, std::size_t operations)
+{
+	std::ios::fmtflags		flags = std::cout.flags();
+	std::streamsize			precision = std::cout.precision();
+	bench_clock::time_point	start;
+	double					ns;
+
+	counters.start();
+	start = bench_clock::now();
+	workload(operations);
+	ns = std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+	counters.stop();
+
+	std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << ns / operations;
+	for (std::size_t i = 0; i < eventCount; ++i)
+	{
+		double	count = counters.read(i);
+
+		if (count < 0)
+			std::cout << std::setw(11) << "-";
+		else
+			std::cout << std::setw(11) << count / operations;
+	}
+	std::cout << std::endl;
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+}
+
+// --- Workloads --- //
+// Each one builds what it needs outside of the measured section when
+// possible, through a functor holding the container.
+
+template <class Vector>
+struct vector_push
+{
+	void	operator()(std::size_t n) const
+	{
+		Vector	v;
+
+		for (std::size_t i = 0; i < n; ++i)
+			v.push_back(i);
+		sink += v[n / 2];
+	}
+};
+
+template <class Vector>
+struct vector_random_read
+{
+	Vector	*v;
+
+	void	operator()(std::size_t n) const
+	{
+		bench_key	state = 88172645463325252ULL;
+		bench_key	sum = 0;
+
+		for (std::size_t i = 0; i < n; ++i)
+			sum += (*v)[nextRandom(state) % v->size()];
+		sink += sum;
+	}
+};
+
+template <class Map>
+struct map_insert
+{
+	Map	*m;
+
+	void	operator()(std::size_t n) const
+	{
+		bench_key	state = 2463534242ULL;
+
+		for (std::size_t i = 0; i < n; ++i)
+			m->insert(typename Map::value_type(nextRandom(state), i));
+	}
+};
+
+template <class Map>
+struct map_lookup
+{
+	Map			*m;
+	bench_key	seed;
+
+	// Replays the insertion sequence, so every key is found
+	void	operator()(std::size_t n) const
+	{
+		bench_key	state = seed;
+		bench_key	sum = 0;
+
+		for (std::size_t i = 0; i < n; ++i)
+			sum += m->at(nextRandom(state));
+		sink += sum;
+	}
+};
+
+template <class Map>
+struct map_iterate
+{
+	Map	*m;
+
+	void	operator()(std::size_t) const
+	{
+		bench_key	sum = 0;
+
+		for (typename Map::const_iterator it = m->begin(); it != m->end(); ++it)
+			sum += it->second;
+		sink += sum;
+	}
+};
+
+template <class Stack>
+struct stack_push_pop
+{
+	void	operator()(std::size_t n) const
+	{
+		Stack	s;
+
+		for (std::size_t i = 0; i < n; ++i)
+			s.push(i);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			sink += s.top();
+			s.pop();
+		}
+	}
+};
+
+template <class Vector, class Map, class Stack>
+static void	benchAll(perf_counters &counters, const std::string &prefix, std::size_t n)
+{
+	Vector	v;
+	Map		m;
+
+	for (std::size_t i = 0; i < n; ++i)
+		v.push_back(i);
+
+	measure(counters, prefix + "vector push_back", vector_push<Vector>(), n);
+	vector_random_read<Vector>	read = { &v };
+	measure(counters, prefix + "vector random read", read, n);
+
+	map_insert<Map>		insert = { &m };
+	measure(counters, prefix + "map insert", insert, n);
+	map_lookup<Map>		lookup = { &m, 2463534242ULL };
+	measure(counters, prefix + "map lookup", lookup, n);
+	map_iterate<Map>	iterate = { &m };
+	measure(counters, prefix + "map iterate", iterate, m.size());
+
+	measure(counters, prefix + "stack push+pop", stack_push_pop<Stack>(), n);
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t		n = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+	perf_counters	counters;
+
+	if (n == 0)
+		n = 1;
+	std::cout << n << " operations per workload, counts per operation" << std::endl;
+	printHeader(counters);
+	benchAll<std::vector<bench_key>, std::map<bench_key, bench_key>, std::stack<bench_key> >(counters, "std ", n);
+	benchAll<ft::vector<bench_key>, ft::map<bench_key, bench_key>, ft::stack<bench_key> >(counters, "ft  ", n);
+	std::cout << "(" << (sink & 0xff) << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include "priority_queue.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Priority queue                                                            //
+// -------------------------------------------------------------------------- //
+// Compares std::priority_queue (binary heap) with ft::priority_queue at
+// arities 2, 4 and 8 on min-heaps of 64-bit deadlines:
+//   - fill:  push n random keys then pop them all,
+//   - timer: keep n timers and repeatedly fire the earliest one and re-arm
+//            it later, with pop() + push() for std and pop_push() for ft.
+//
+// Usage: ./bench/priority_queue [n] [timer operations]
+
+typedef std::chrono::steady_clock	bench_clock;
+typedef unsigned long long			deadline;
+
+static deadline	nextRandom(deadline &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static double	elapsedMs(bench_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+// --- Adapters over the two replace-top flavours --- //
+template <class Queue>
+static void	replaceTop(Queue &queue, const deadline &value)
+{
+	queue.pop_push(value);
+}
+
+template <>
+void	replaceTop(std::priority_queue<deadline, std::vector<deadline>, std::greater<deadline> > &queue, const deadline &value)
+{
+	queue.pop();
+	queue.push(value);
+}
+
+template <class Queue>
+static void	benchQueue(const std::string &name, std::size_t n, std::size_t operations)
+{
+	deadline				state = 88172645463325252ULL;
+	deadline				checksum = 0;
+	bench_clock::time_point	start;
+	double					fillMs;
+	double					timerMs;
+
+	{
+		Queue	queue;
+
+		start = bench_clock::now();
+		for (std::size_t i = 0; i < n; ++i)
+			queue.push(nextRandom(state));
+		while (!queue.empty())
+		{
+			checksum += queue.top();
+			queue.pop();
+		}
+		fillMs = elapsedMs(start);
+	}
+
+	{
+		Queue	queue;
+
+		for (std::size_t i = 0; i < n; ++i)
+			queue.push(nextRandom(state) % (n * 16));
+		start = bench_clock::now();
+		for (std::size_t i = 0; i < operations; ++i)
+		{
+			deadline	now = queue.top();
+
+			checksum += now;
+			replaceTop(queue, now + nextRandom(state) % (n * 16));
+		}
+		timerMs = elapsedMs(start);
+	}
+
+	std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+		<< "  fill " << std::setw(8) << fillMs << " ms"
+		<< "  timer " << std::setw(8) << timerMs << " ms"
+		<< "  (" << (checksum & 0xff) << ")" << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t	n = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+	std::size_t	operations = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 5000000;
+
+	if (n == 0)
+		n = 1;
+	std::cout << n << " elements, " << operations << " timer operations" << std::endl;
+	benchQueue<std::priority_queue<deadline, std::vector<deadline>, std::greater<deadline> > >("std (binary)", n, operations);
+	benchQueue<ft::priority_queue<deadline, ft::vector<deadline>, std::greater<deadline>, 2> >("ft arity 2", n, operations);
+	benchQueue<ft::priority_queue<deadline, ft::vector<deadline>, std::greater<deadline>, 4> >("ft arity 4", n, operations);
+	benchQueue<ft::priority_queue<deadline, ft::vector<deadline>, std::greater<deadline>, 8> >("ft arity 8", n, operations);
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include "soa_vector.hpp"
+#include "vector.hpp"
+#include "pair.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Structure of arrays                                                       //
+// -------------------------------------------------------------------------- //
+// Compares ft::vector<ft::pair<key, value> > with ft::soa_vector<key, value>
+// on 64-bit keys and values:
+//   - key scan:    counts the keys below a threshold, the values are not
+//                  read; the soa_vector one runs over first_data(),
+//   - record scan: sums keys and values through the iterators.
+// Every scan is repeated over the whole container, best time kept.
+//
+// Usage: ./bench/soa_vector [n] [rounds]
+
+typedef std::chrono::steady_clock	bench_clock;
+typedef unsigned long long			bench_key;
+
+typedef ft::vector< ft::pair<bench_key, bench_key> >	aos_type;
+typedef ft::soa_vector<bench_key, bench_key>			soa_type;
+
+static bench_key	nextRandom(bench_key &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+// --- Scans --- //
+static bench_key	keyScan(const aos_type &records, bench_key threshold)
+{
+	const ft::pair<bench_key, bench_key>	*data = records.data();
+	bench_key								count = 0;
+
+	for (std::size_t i = 0; i < records.size(); ++i)
+		count += data[i].first < threshold;
+	return count;
+}
+
+static bench_key	keyScan(const soa_type &records, bench_key threshold)
+{
+	const bench_key	*keys = records.first_data();
+	bench_key		count = 0;
+
+	for (std::size_t i = 0; i < records.size(); ++i)
+		count += keys[i] < threshold;
+	return count;
+}
+
+template <class Records>
+static bench_key	recordScan(const Records &records, bench_key)
+{
+	bench_key	sum = 0;
+
+	for (typename Records::const_iterator it = records.begin(); it != records.end(); ++it)
+		sum += (*it).first ^ (*it).second;
+	return sum;
+}
+
+// Best time of rounds runs, in nanoseconds per record
+template <class Records>
+static double	bestNs(const Records &records, bench_key (*scan)(const Records &, bench_key),
+	std::size_t rounds, bench_key &checksum)
+{
+	double	best = 0;
+
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		bench_clock::time_point	start = bench_clock::now();
+		double					ns;
+
+		checksum += scan(records, ~0ULL / 2 + round);
+		ns = std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+		if (round == 0 || ns < best)
+			best = ns;
+	}
+	return best / records.size();
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t	n = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 4000000;
+	std::size_t	rounds = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 20;
+	bench_key	state = 88172645463325252ULL;
+	bench_key	checksum = 0;
+	aos_type	aos;
+	soa_type	soa;
+
+	if (n == 0)
+		n = 1;
+	if (rounds == 0)
+		rounds = 1;
+	aos.reserve(n);
+	soa.reserve(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		bench_key	key = nextRandom(state);
+		bench_key	value = nextRandom(state);
+
+		aos.push_back(ft::pair<bench_key, bench_key>(key, value));
+		soa.push_back(key, value);
+	}
+
+	double	aosKeys = bestNs<aos_type>(aos, keyScan, rounds, checksum);
+	double	soaKeys = bestNs<soa_type>(soa, keyScan, rounds, checksum);
+	double	aosRecords = bestNs<aos_type>(aos, recordScan<aos_type>, rounds, checksum);
+	double	soaRecords = bestNs<soa_type>(soa, recordScan<soa_type>, rounds, checksum);
+
+	std::cout << n << " records, best of " << rounds << " rounds, ns per record" << std::endl;
+	std::cout << std::fixed << std::setprecision(3)
+		<< "key scan      vector<pair> " << std::setw(7) << aosKeys
+		<< "  soa_vector " << std::setw(7) << soaKeys
+		<< "  x" << std::setprecision(2) << aosKeys / soaKeys << std::endl;
+	std::cout << std::fixed << std::setprecision(3)
+		<< "record scan   vector<pair> " << std::setw(7) << aosRecords
+		<< "  soa_vector " << std::setw(7) << soaRecords
+		<< "  x" << std::setprecision(2) << aosRecords / soaRecords << std::endl;
+	std::cout << "(" << (checksum & 0xff) << ")" << std::endl;
+	return 0;
+}
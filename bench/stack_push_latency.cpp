@@ -0,0 +1,74 @@
+#include "stack.hpp"
+#include "vector.hpp"
+#include "deque.hpp"
+#include "incremental_vector.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Stack push tail latency                                                   //
+// -------------------------------------------------------------------------- //
+// Times every single push onto a stack backed by ft::vector, ft::deque and
+// ft::incremental_vector, and prints the latency distribution. The vector
+// backend reallocates and copies everything when it crosses a capacity
+// boundary, which shows up in the highest percentiles.
+//
+// Usage: ./bench/stack_push_latency [pushes]
+
+typedef std::chrono::steady_clock	bench_clock;
+
+template <class Stack>
+static void	benchPush(const std::string &name, std::size_t pushes)
+{
+	Stack				stack;
+	std::vector<long>	latencies(pushes);
+	bench_clock::time_point	total = bench_clock::now();
+
+	for (std::size_t i = 0; i < pushes; ++i)
+	{
+		bench_clock::time_point	start = bench_clock::now();
+
+		stack.push(static_cast<int>(i));
+		latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start).count();
+	}
+	double	totalMs = std::chrono::duration<double, std::milli>(bench_clock::now() - total).count();
+
+	std::sort(latencies.begin(), latencies.end());
+
+	const double	percentiles[] = { 50, 90, 99, 99.9, 99.99, 99.999 };
+
+	std::cout << std::left << std::setw(12) << name;
+	for (std::size_t i = 0; i < sizeof(percentiles) / sizeof(*percentiles); ++i)
+	{
+		std::size_t	index = static_cast<std::size_t>(percentiles[i] / 100.0 * (pushes - 1));
+
+		std::cout << "  p" << percentiles[i] << " " << latencies[index] << " ns";
+	}
+	std::ios::fmtflags	flags = std::cout.flags();
+	std::streamsize		precision = std::cout.precision();
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "  max " << latencies.back() / 1000.0 << " us"
+		<< "  total " << totalMs << " ms" << std::endl;
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t	pushes = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 10000000;
+
+	if (pushes == 0)
+		pushes = 1;
+	std::cout << "Pushing " << pushes << " ints" << std::endl;
+	benchPush<ft::stack<int, ft::vector<int> > >("vector", pushes);
+	benchPush<ft::stack<int, ft::deque<int> > >("deque", pushes);
+	benchPush<ft::stack<int, ft::incremental_vector<int> > >("incremental", pushes);
+	return 0;
+}
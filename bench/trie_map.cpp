@@ -0,0 +1,142 @@
+#include "map.hpp"
+#include "trie_map.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+// -------------------------------------------------------------------------- //
+//  Trie map                                                                  //
+// -------------------------------------------------------------------------- //
+// Random lookups with find() of present string keys sharing long prefixes,
+// like "tenant:42:user:00012345", in std::map, ft::map and ft::trie_map, then
+// a prefix_range() scan against the lower_bound() walk std::map needs for it.
+// A tree compares the shared prefix again at every level; the trie reads
+// each byte of the key once.
+//
+// Usage: ./bench/trie_map [lookups]
+
+typedef std::chrono::steady_clock	bench_clock;
+typedef unsigned long long			bench_key;
+
+static bench_key	nextRandom(bench_key &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static bench_key	sink = 0;	// Keeps the lookups from being optimized out
+
+template <class Map>
+static double	measureFind(const Map &m, const std::vector<std::string> &keys, std::size_t lookups)
+{
+	bench_clock::time_point	start = bench_clock::now();
+	bench_key				sum = 0;
+
+	for (std::size_t i = 0; i < lookups; ++i)
+		sum += m.find(keys[i % keys.size()])->second;
+	sink += sum;
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / lookups;
+}
+
+// Sums the elements of every tenant, in nanoseconds per element
+template <class Map>
+static double	measureScan(const Map &m, const std::vector<std::string> &prefixes, std::size_t n)
+{
+	bench_clock::time_point	start = bench_clock::now();
+	bench_key				sum = 0;
+
+	for (std::size_t p = 0; p < prefixes.size(); ++p)
+	{
+		typename Map::const_iterator	it = m.lower_bound(prefixes[p]);
+
+		for (; it != m.end() && it->first.compare(0, prefixes[p].size(), prefixes[p]) == 0; ++it)
+			sum += it->second;
+	}
+	sink += sum;
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / n;
+}
+
+static double	measureTrieScan(const ft::trie_map<std::string, bench_key> &m,
+	const std::vector<std::string> &prefixes, std::size_t n)
+{
+	bench_clock::time_point	start = bench_clock::now();
+	bench_key				sum = 0;
+
+	for (std::size_t p = 0; p < prefixes.size(); ++p)
+	{
+		ft::pair<ft::trie_map<std::string, bench_key>::const_iterator,
+			ft::trie_map<std::string, bench_key>::const_iterator>	range = m.prefix_range(prefixes[p]);
+
+		for (; range.first != range.second; ++range.first)
+			sum += range.first->second;
+	}
+	sink += sum;
+	return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / n;
+}
+
+static void	benchSize(std::size_t n, std::size_t lookups)
+{
+	const std::size_t							tenants = 64;
+	bench_key									state = 88172645463325252ULL;
+	std::map<std::string, bench_key>			stdMap;
+	ft::map<std::string, bench_key>				ftMap;
+	ft::trie_map<std::string, bench_key>		trie;
+	std::vector<std::string>					keys;
+	std::vector<std::string>					prefixes;
+	char										buffer[64];
+
+	for (std::size_t t = 0; t < tenants; ++t)
+	{
+		std::snprintf(buffer, sizeof(buffer), "tenant:%zu:user:", t);
+		prefixes.push_back(buffer);
+	}
+	while (keys.size() < n)
+	{
+		bench_key	r = nextRandom(state);
+
+		std::snprintf(buffer, sizeof(buffer), "tenant:%llu:user:%08llu", r % tenants, (r >> 8) % 100000000);
+		if (!stdMap.insert(std::make_pair(std::string(buffer), r)).second)
+			continue ;
+		ftMap.insert(ft::make_pair(std::string(buffer), r));
+		trie.insert(ft::make_pair(std::string(buffer), r));
+		keys.push_back(buffer);
+	}
+	for (std::size_t i = keys.size(); i > 1; --i)
+		std::swap(keys[i - 1], keys[nextRandom(state) % i]);
+
+	double	stdNs = measureFind(stdMap, keys, lookups);
+	double	ftNs = measureFind(ftMap, keys, lookups);
+	double	trieNs = measureFind(trie, keys, lookups);
+	double	stdScan = measureScan(stdMap, prefixes, n);
+	double	trieScan = measureTrieScan(trie, prefixes, n);
+
+	std::cout << std::setw(9) << n << std::fixed << std::setprecision(1)
+		<< std::setw(11) << stdNs << std::setw(11) << ftNs << std::setw(11) << trieNs
+		<< "   x" << std::setprecision(2) << ftNs / trieNs
+		<< std::setprecision(1) << std::setw(11) << stdScan << std::setw(11) << trieScan << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	std::size_t			lookups = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000000;
+	const std::size_t	sizes[] = { 1000, 100000, 1000000 };
+
+	if (lookups == 0)
+		lookups = 1;
+	std::cout << lookups << " random lookups with find(), ns per lookup; scans in ns per element" << std::endl;
+	std::cout << std::setw(9) << "size" << std::setw(11) << "std::map" << std::setw(11) << "ft::map"
+		<< std::setw(11) << "trie_map" << "   vs ft  " << std::setw(11) << "std scan" << std::setw(11) << "trie scan"
+		<< std::endl;
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+		benchSize(sizes[i], lookups);
+	std::cout << "(" << (sink & 0xff) << ")" << std::endl;
+	return 0;
+}
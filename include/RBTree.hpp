@@ -5,8 +5,15 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <algorithm>
 
+#include "iterators.hpp"
+#include "utility.hpp"
 #include "RBTree_iterator.hpp"
+#include "tree_augment.hpp"
+#include "tree_key_prefix.hpp"
+#include "stats.hpp"
+#include "allocator_traits.hpp"
 
 namespace ft
 {
@@ -18,20 +25,32 @@ namespace ft
 	 * 3. Every leaf (nullptr) is black.
 	 * 4. If a node is red, then both its children are black.
 	 * 5. All paths to a leaf contain the same number of black nodes.
+	 *
+	 * Elements are ordered by the key KeyOfValue extracts from them, Compare
+	 * being called on keys only. insert() keeps keys unique, insertMulti()
+	 * accepts equivalent keys and keeps them in insertion order.
+	 *
+	 * Nodes may carry extra data about their subtree, kept up to date by
+	 * the Augment policy, see tree_augment.hpp, and a prefix of their key
+	 * checked before the key itself, see tree_key_prefix.hpp.
 	 */
 	template <
 		typename T,
 		typename Compare = std::less<T>,
-		typename Allocator = std::allocator<T> >
-	class RBTree
+		typename Allocator = std::allocator<T>,
+		typename KeyOfValue = ft::identity<T>,
+		typename Augment = ft::no_augment,
+		typename KeyPrefix = typename ft::key_prefix_for<Compare>::type >
+	class RBTree: public ft::stats_policy
 	{
 		public:
 			// -------------------------------------------------------------- //
 			//  Member types                                                  //
 			// -------------------------------------------------------------- //
-			typedef T			value_type;
-			typedef Compare		key_compare;
-			typedef Allocator	allocator_type;
+			typedef T								value_type;
+			typedef typename KeyOfValue::key_type	key_type;
+			typedef Compare							key_compare;
+			typedef Allocator						allocator_type;
 
 			typedef T&			reference;
 			typedef const T&	const_reference;
@@ -41,7 +60,7 @@ namespace ft
 			typedef std::ptrdiff_t	difference_type;
 			typedef std::size_t		size_type;
 
-			struct Node
+			struct Node: public Augment::node_base, public KeyPrefix::node_base
 			{
 				enum Color
 				{
@@ -54,13 +73,24 @@ namespace ft
 				Node		*parent;
 				Node		*left;
 				Node		*right;
+				size_type	count;		// Number of nodes in this subtree
+#ifdef FT_THREADED_TREE
+				// In-order threads, the last node's next is the end sentinel
+				Node		*prev;
+				Node		*next;
+#endif
 
 				Node(const_reference data):
 					data(data),
 					color(RED),
 					parent(nullptr),
 					left(nullptr),
-					right(nullptr)
+					right(nullptr),
+					count(1)
+#ifdef FT_THREADED_TREE
+					, prev(nullptr),
+					next(nullptr)
+#endif
 				{}
 			};
 
@@ -71,14 +101,21 @@ namespace ft
 			typedef Node		&node_reference;
 			typedef const Node	&const_node_reference;
 
+			typedef typename KeyPrefix::prefix_type	prefix_type;
+
+			// Nodes come from the same allocator, or memory resource, as the
+			// one given for the elements
+			typedef typename Allocator::template rebind<Node>::other	node_allocator_type;
+			typedef ft::allocator_traits<Allocator>						alloc_traits;
+
 			// -------------------------------------------------------------- //
 			//  Iterators                                                     //
 			// -------------------------------------------------------------- //
-			typedef RBTree_iterator<RBTree<T, Compare, Allocator> >			iterator;
-			typedef RBTree_iterator<const RBTree<T, Compare, Allocator> >	const_iterator;
+			typedef RBTree_iterator<RBTree>			iterator;
+			typedef RBTree_iterator<const RBTree>	const_iterator;
 
-			typedef ft::reverse_iterator<iterator>							reverse_iterator;
-			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+			typedef ft::reverse_iterator<iterator>			reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
 
 		private:
 			node_pointer	newNode(const_reference data)
@@ -86,17 +123,25 @@ namespace ft
 				node_pointer	node = _nodeAllocator.allocate(1);
 
 				_nodeAllocator.construct(node, data);
+				KeyPrefix::set(*node, KeyPrefix::prefix(keyOf(node->data)));
+				updateAugment(node);
+				countNodeAllocation();
 				return node;
 			}
 
+			void	destroyNode(node_pointer node)
+			{
+				_nodeAllocator.destroy(node);
+				_nodeAllocator.deallocate(node, 1);
+			}
+
 			void	deleteNode(node_pointer *node)
 			{
 				if (node == nullptr || *node == nullptr)
 					return ;
 
 				replaceChildParent((*node)->parent, *node, nullptr);
-				_nodeAllocator.destroy(*node);
-				_nodeAllocator.deallocate(*node, 1);
+				destroyNode(*node);
 				*node = nullptr;
 			}
 
@@ -114,14 +159,64 @@ namespace ft
 				_size = 0;
 			}
 
-			void	copyTree(const_node_pointer copyNode, const_node_pointer _end)
+			// Clones the shape, colors and counts of a subtree in O(n), so
+			// that equivalent keys keep their order.
+			node_pointer	copyTree(const_node_pointer copyNode, const_node_pointer otherEnd, node_pointer parent)
 			{
-				if (copyNode == nullptr || copyNode == _end)
-					return ;
+				node_pointer	node;
+
+				if (copyNode == nullptr || copyNode == otherEnd)
+					return nullptr;
+
+				node = newNode(copyNode->data);
+				node->color = copyNode->color;
+				node->count = copyNode->count;
+				node->parent = parent;
+				node->left = copyTree(copyNode->left, otherEnd, node);
+				node->right = copyTree(copyNode->right, otherEnd, node);
+				updateAugment(node);
+				return node;
+			}
+
+			void	copyTree(const RBTree &other)
+			{
+				_root = copyTree(other._root, &other._end, nullptr);
+				_size = other._size;
+				rethread();
+				updateEndNode();
+			}
 
-				insert(copyNode->data);
-				copyTree(copyNode->left, _end);
-				copyTree(copyNode->right, _end);
+			static const key_type	&keyOf(const_reference data)
+			{
+				return KeyOfValue()(data);
+			}
+
+			bool	keyLess(const key_type &lhs, const key_type &rhs) const
+			{
+				countComparisons();
+				return _comparator(lhs, rhs);
+			}
+
+			// Same as keyLess() against the key of node, keyPrefix being the
+			// prefix of key: the full keys are only read when the prefixes tie
+			bool	keyLess(const key_type &key, prefix_type keyPrefix, const_node_pointer node) const
+			{
+				int	order = KeyPrefix::compare(keyPrefix, *node);
+
+				if (order == 0)
+					return keyLess(key, keyOf(node->data));
+				countComparisons();
+				return order < 0;
+			}
+
+			bool	keyLess(const_node_pointer node, const key_type &key, prefix_type keyPrefix) const
+			{
+				int	order = KeyPrefix::compare(keyPrefix, *node);
+
+				if (order == 0)
+					return keyLess(keyOf(node->data), key);
+				countComparisons();
+				return order > 0;
 			}
 
 			bool	isBlack(node_pointer node)
@@ -129,6 +224,68 @@ namespace ft
 				return (node == nullptr || node->color == Node::BLACK);
 			}
 
+			// The end sentinel counts for zero
+			static size_type	countOf(const_node_pointer node)
+			{
+				return (node == nullptr ? 0 : node->count);
+			}
+
+			// The end sentinel is not part of the augmented subtree
+			void	updateAugment(node_pointer node)
+			{
+				Augment::update(*node,
+					static_cast<const_node_pointer>(node->left),
+					static_cast<const_node_pointer>(node->right == &_end ? nullptr : node->right),
+					_comparator);
+			}
+
+			// Recomputes the count and augmentation of node from its children
+			void	updateNode(node_pointer node)
+			{
+				node->count = countOf(node->left) + countOf(node->right) + 1;
+				updateAugment(node);
+			}
+
+			void	addToAncestors(node_pointer node, size_type n, bool add)
+			{
+				for (; node != nullptr; node = node->parent)
+				{
+					node->count = add ? node->count + n : node->count - n;
+					updateAugment(node);
+				}
+			}
+
+			void	updateAugmentOfAncestors(node_pointer node)
+			{
+				for (; node != nullptr; node = node->parent)
+					updateAugment(node);
+			}
+
+			void	recolor(node_pointer node, typename Node::Color color)
+			{
+				if (node->color != color)
+					countRecoloring();
+				node->color = color;
+			}
+
+			size_type	height(const_node_pointer node) const
+			{
+				if (node == nullptr || node == &_end)
+					return 0;
+				return 1 + std::max(height(node->left), height(node->right));
+			}
+
+			size_type	blackHeight(void) const
+			{
+				size_type			count = 0;
+				const_node_pointer	node = _root;
+
+				for (; node != nullptr; node = node->left)
+					if (node->color == Node::BLACK)
+						++count;
+				return count;
+			}
+
 			void replaceChildParent(node_pointer parent, node_pointer oldChild, node_pointer newChild)
 			{
 				if (parent == nullptr)
@@ -144,7 +301,9 @@ namespace ft
 					newChild->parent = parent;
 			}
 
-			node_pointer	deleteWithZeroOrOneChild(node_pointer node, node_pointer *movedParentNode)
+			// Takes out a node having at most one child, the node itself is
+			// left allocated.
+			node_pointer	unlinkWithZeroOrOneChild(node_pointer node, node_pointer *movedParentNode)
 			{
 				node_pointer	moved = nullptr;
 
@@ -170,10 +329,126 @@ namespace ft
 					moved = nullptr;
 				}
 
-				deleteNode(&node);
 				return moved;
 			}
 
+			// -------------------------------------------------------------- //
+			//  Threads                                                       //
+			// -------------------------------------------------------------- //
+			// With FT_THREADED_TREE, every node is linked to its in-order
+			// neighbours so that iterators step with a single load. Rotations
+			// keep the in-order sequence, so only insertion and removal have
+			// to update the links.
+#ifdef FT_THREADED_TREE
+			void	threadBefore(node_pointer node, node_pointer next)
+			{
+				node->next = next;
+				node->prev = next->prev;
+				if (node->prev != nullptr)
+					node->prev->next = node;
+				next->prev = node;
+			}
+
+			void	threadAfter(node_pointer node, node_pointer prev)
+			{
+				node->prev = prev;
+				node->next = prev->next;
+				node->next->prev = node;
+				prev->next = node;
+			}
+
+			void	unthread(node_pointer node)
+			{
+				if (node->prev != nullptr)
+					node->prev->next = node->next;
+				node->next->prev = node->prev;
+			}
+
+			void	resetThreads(void)
+			{
+				_end.prev = nullptr;
+			}
+
+			// Each thread ends at the sentinel of the tree it moved to
+			void	swapThreads(RBTree &other)
+			{
+				std::swap(_end.prev, other._end.prev);
+				if (_end.prev != nullptr)
+					_end.prev->next = &_end;
+				if (other._end.prev != nullptr)
+					other._end.prev->next = &other._end;
+			}
+
+			// Links the neighbours of the [first, last) range together
+			void	unthreadRange(node_pointer first, node_pointer last)
+			{
+				if (first->prev != nullptr)
+					first->prev->next = last;
+				last->prev = first->prev;
+			}
+
+			// Ends the thread of this tree right before node, node and its
+			// followers moving to the thread of other.
+			void	splitThreads(node_pointer node, RBTree &other)
+			{
+				node_pointer	last = _end.prev;
+
+				if (node->prev != nullptr)
+					node->prev->next = &_end;
+				_end.prev = node->prev;
+				node->prev = nullptr;
+				last->next = &other._end;
+				other._end.prev = last;
+			}
+
+			// Appends the thread of other, starting at first, to this tree
+			void	joinThreads(node_pointer first, RBTree &other)
+			{
+				node_pointer	last = other._end.prev;
+
+				if (_end.prev != nullptr)
+					_end.prev->next = first;
+				first->prev = _end.prev;
+				last->next = &_end;
+				_end.prev = last;
+				other._end.prev = nullptr;
+			}
+
+			void	threadSubtree(node_pointer node, node_pointer *prev)
+			{
+				if (node == nullptr || node == &_end)
+					return ;
+
+				threadSubtree(node->left, prev);
+				node->prev = *prev;
+				if (*prev != nullptr)
+					(*prev)->next = node;
+				*prev = node;
+				threadSubtree(node->right, prev);
+			}
+
+			// Links the whole tree again, after it has been copied
+			void	rethread(void)
+			{
+				node_pointer	last = nullptr;
+
+				threadSubtree(_root, &last);
+				if (last != nullptr)
+					last->next = &_end;
+				_end.prev = last;
+			}
+#else
+			void	threadBefore(node_pointer, node_pointer) {}
+			void	threadAfter(node_pointer, node_pointer) {}
+			void	unthread(node_pointer) {}
+			void	resetThreads(void) {}
+			void	swapThreads(RBTree &) {}
+			void	unthreadRange(node_pointer, node_pointer) {}
+			void	splitThreads(node_pointer, RBTree &) {}
+			void	joinThreads(node_pointer, RBTree &) {}
+			void	rethread(void) {}
+#endif
+
 			/**
 			 * Rotation exemple:
 			 *       │               │
@@ -192,6 +467,7 @@ namespace ft
 				if (leftChild == nullptr)
 					return ;
 
+				countRotation();
 				node->left = leftChild->right;
 				if (node->left != nullptr)
 					node->left->parent = node;
@@ -199,6 +475,8 @@ namespace ft
 				leftChild->right = node;
 				node->parent = leftChild;
 
+				updateNode(node);
+				updateNode(leftChild);
 				replaceChildParent(parent, node, leftChild);
 			}
 
@@ -220,6 +498,7 @@ namespace ft
 				if (rightChild == nullptr)
 					return ;
 
+				countRotation();
 				node->right = rightChild->left;
 				if (node->right != nullptr)
 					node->right->parent = node;
@@ -227,6 +506,8 @@ namespace ft
 				rightChild->left = node;
 				node->parent = rightChild;
 
+				updateNode(node);
+				updateNode(rightChild);
 				replaceChildParent(parent, node, rightChild);
 			}
 
@@ -238,6 +519,7 @@ namespace ft
 					return ;
 
 				replaceChildParent(parent, &_end, nullptr);
+				_end.parent = nullptr;
 
 			}
 
@@ -248,14 +530,16 @@ namespace ft
 				if (node == nullptr)
 					return ;
 
-				while (node->right != nullptr)
+				while (node->right != nullptr && node->right != &_end)
 					node = node->right;
 
 				node->right = &_end;
 				_end.parent = node;
 			}
 
-			void	fixTreeInsertion(node_pointer node)
+			// Returns true when the fix-up reached the root and blackened it,
+			// which adds one to the black height of the tree.
+			bool	fixTreeInsertion(node_pointer node)
 			{
 				node_pointer	parent = node->parent;
 				node_pointer	uncle = nullptr;
@@ -264,13 +548,15 @@ namespace ft
 				// If node is the root
 				if (parent == nullptr)
 				{
-					node->color = Node::BLACK;
-					return ;
+					bool	grew = (node->color == Node::RED);
+
+					recolor(node, Node::BLACK);
+					return grew;
 				}
 
 				// If node's parent is black
 				if (parent->color == Node::BLACK)
-					return ;
+					return false;
 
 				// Node's parent is red for sure
 
@@ -280,11 +566,10 @@ namespace ft
 				// If node's uncle is red
 				if (!isBlack(uncle))
 				{
-					parent->color = Node::BLACK;
-					uncle->color = Node::BLACK;
-					grandParent->color = Node::RED;
-					fixTreeInsertion(grandParent);
-					return ;
+					recolor(parent, Node::BLACK);
+					recolor(uncle, Node::BLACK);
+					recolor(grandParent, Node::RED);
+					return fixTreeInsertion(grandParent);
 				}
 
 				// If node's uncle is black
@@ -309,8 +594,9 @@ namespace ft
 					leftRotation(grandParent);
 				}
 
-				parent->color = Node::BLACK;
-				grandParent->color = Node::RED;
+				recolor(parent, Node::BLACK);
+				recolor(grandParent, Node::RED);
+				return false;
 			}
 
 			void	fixTreeDeletion(node_pointer moveNode, node_pointer parent)
@@ -321,7 +607,7 @@ namespace ft
 				if (parent == nullptr)
 				{
 					if (moveNode != nullptr)
-						moveNode->color = Node::BLACK;
+						recolor(moveNode, Node::BLACK);
 					return ;
 				}
 
@@ -331,8 +617,8 @@ namespace ft
 				if (sibling->color == Node::RED)
 				{
 					// Recoloring
-					sibling->color = Node::BLACK;
-					parent->color = Node::RED;
+					recolor(sibling, Node::BLACK);
+					recolor(parent, Node::RED);
 
 					// Rotation
 					if (parent->left == moveNode)
@@ -348,12 +634,12 @@ namespace ft
 				if (isBlack(sibling->left) && isBlack(sibling->right))
 				{
 					// Recoloring
-					sibling->color = Node::RED;
+					recolor(sibling, Node::RED);
 
 					// If parent is red
 					if (parent->color == Node::RED)
 					{
-						parent->color = Node::BLACK;
+						recolor(parent, Node::BLACK);
 						return ;
 					}
 
@@ -368,8 +654,8 @@ namespace ft
 				if (isLeft && isBlack(sibling->right))
 				{
 					// Recoloring
-					sibling->color = Node::RED;
-					sibling->left->color = Node::BLACK;
+					recolor(sibling, Node::RED);
+					recolor(sibling->left, Node::BLACK);
 
 					// Rotation
 					rightRotation(sibling);
@@ -380,8 +666,8 @@ namespace ft
 				else if (!isLeft && isBlack(sibling->left))
 				{
 					// Recoloring
-					sibling->color = Node::RED;
-					sibling->right->color = Node::BLACK;
+					recolor(sibling, Node::RED);
+					recolor(sibling->right, Node::BLACK);
 
 					// Rotation
 					leftRotation(sibling);
@@ -391,28 +677,195 @@ namespace ft
 				}
 
 				// Recoloring
-				sibling->color = parent->color;
-				parent->color = Node::BLACK;
+				recolor(sibling, parent->color);
+				recolor(parent, Node::BLACK);
 
 				// Rotation
 				if (isLeft)
 				{
-					sibling->right->color = Node::BLACK;
+					recolor(sibling->right, Node::BLACK);
 					leftRotation(parent);
 				}
 				else
 				{
-					sibling->left->color = Node::BLACK;
+					recolor(sibling->left, Node::BLACK);
 					rightRotation(parent);
 				}
 			}
 
+			// -------------------------------------------------------------- //
+			//  Split / join                                                  //
+			// -------------------------------------------------------------- //
+			// Subtrees handled here are detached (their root has no parent)
+			// and come with their black height, the number of black nodes on
+			// any path from the subtree root down to a leaf. The end sentinel
+			// must be removed beforehand.
+
+			size_type	subtreeBlackHeight(const_node_pointer node) const
+			{
+				size_type	count = 0;
+
+				for (; node != nullptr; node = node->left)
+					if (node->color == Node::BLACK)
+						++count;
+				return count;
+			}
+
+			void	detachSubtree(node_pointer node)
+			{
+				if (node != nullptr)
+					node->parent = nullptr;
+			}
+
+			// Joins left < pivot < right into a single tree in
+			// O(|leftHeight - rightHeight| + 1) and returns its root.
+			node_pointer	joinTrees(node_pointer left, size_type leftHeight, node_pointer pivot,
+				node_pointer right, size_type rightHeight, size_type *height)
+			{
+				node_pointer	current;
+				node_pointer	parent = nullptr;
+				size_type		currentHeight;
+				size_type		added;
+
+				// Red roots are blackened so that both sides end up black rooted
+				if (left != nullptr && left->color == Node::RED)
+				{
+					recolor(left, Node::BLACK);
+					++leftHeight;
+				}
+				if (right != nullptr && right->color == Node::RED)
+				{
+					recolor(right, Node::BLACK);
+					++rightHeight;
+				}
+
+				pivot->parent = nullptr;
+
+				// Same height: the pivot becomes the new root
+				if (leftHeight == rightHeight)
+				{
+					pivot->left = left;
+					pivot->right = right;
+					pivot->color = Node::BLACK;
+					if (left != nullptr)
+						left->parent = pivot;
+					if (right != nullptr)
+						right->parent = pivot;
+					updateNode(pivot);
+					*height = leftHeight + 1;
+					return pivot;
+				}
+
+				// Otherwise the pivot is hung, red, along the spine of the
+				// taller tree, next to a black node as high as the other tree.
+				// Every spine node walked through gains the pivot and the
+				// shorter tree.
+				current = (leftHeight > rightHeight) ? left : right;
+				currentHeight = std::max(leftHeight, rightHeight);
+				added = countOf(leftHeight > rightHeight ? right : left) + 1;
+				while (current != nullptr
+					&& (current->color == Node::RED || currentHeight > std::min(leftHeight, rightHeight)))
+				{
+					if (current->color == Node::BLACK)
+						--currentHeight;
+					current->count += added;
+					parent = current;
+					current = (leftHeight > rightHeight) ? current->right : current->left;
+				}
+
+				pivot->color = Node::RED;
+				pivot->parent = parent;
+				if (leftHeight > rightHeight)
+				{
+					pivot->left = current;
+					pivot->right = right;
+					parent->right = pivot;
+					if (right != nullptr)
+						right->parent = pivot;
+					_root = left;
+				}
+				else
+				{
+					pivot->left = left;
+					pivot->right = current;
+					parent->left = pivot;
+					if (left != nullptr)
+						left->parent = pivot;
+					_root = right;
+				}
+				if (current != nullptr)
+					current->parent = pivot;
+				updateNode(pivot);
+				updateAugmentOfAncestors(parent);
+
+				*height = std::max(leftHeight, rightHeight) + fixTreeInsertion(pivot);
+				return _root;
+			}
+
+			// Cuts the tree holding node into the nodes before it and the
+			// nodes after it, node itself is left alone. Each ancestor is
+			// joined to the side it belongs to, the black heights of the
+			// pieces telescope so the whole split is O(log n).
+			void	splitAt(node_pointer node, node_pointer *left, size_type *leftHeight,
+				node_pointer *right, size_type *rightHeight)
+			{
+				node_pointer	parent = node->parent;
+				bool			fromLeft = (parent != nullptr && parent->left == node);
+				size_type		height = subtreeBlackHeight(node->left);
+
+				*left = node->left;
+				*right = node->right;
+				*leftHeight = height;
+				*rightHeight = height;
+				detachSubtree(*left);
+				detachSubtree(*right);
+
+				// Black height of the subtree rooted at the current ancestor
+				height += (node->color == Node::BLACK);
+
+				node->parent = nullptr;
+				node->left = nullptr;
+				node->right = nullptr;
+				updateNode(node);
+
+				while (parent != nullptr)
+				{
+					node_pointer	grandParent = parent->parent;
+					bool			parentFromLeft = (grandParent != nullptr && grandParent->left == parent);
+					bool			parentBlack = (parent->color == Node::BLACK);
+					node_pointer	sibling = fromLeft ? parent->right : parent->left;
+
+					detachSubtree(sibling);
+					if (fromLeft)
+						*right = joinTrees(*right, *rightHeight, parent, sibling, height, rightHeight);
+					else
+						*left = joinTrees(sibling, height, parent, *left, *leftHeight, leftHeight);
+
+					height += parentBlack;
+					fromLeft = parentFromLeft;
+					parent = grandParent;
+				}
+			}
+
+			// Frees a detached subtree and returns how many nodes it held
+			size_type	destroySubtree(node_pointer node)
+			{
+				size_type	count;
+
+				if (node == nullptr)
+					return 0;
+
+				count = 1 + destroySubtree(node->left) + destroySubtree(node->right);
+				destroyNode(node);
+				return count;
+			}
+
 		private:
 			node_pointer			_root;
 			Node					_end;
 			key_compare				_comparator;
 			allocator_type			_allocator;
-			std::allocator<Node>	_nodeAllocator;
+			node_allocator_type		_nodeAllocator;
 
 			size_type				_size;
 
@@ -427,10 +880,11 @@ namespace ft
 				_end(value_type()),
 				_comparator(key_compare()),
 				_allocator(allocator_type()),
-				_nodeAllocator(std::allocator<Node>()),
+				_nodeAllocator(_allocator),
 				_size(0)
 			{
 				_end.color = Node::BLACK;
+				_end.count = 0;
 			}
 
 			explicit RBTree(const key_compare &comp, const allocator_type &alloc = allocator_type()):
@@ -438,31 +892,38 @@ namespace ft
 				_end(value_type()),
 				_comparator(comp),
 				_allocator(alloc),
-				_nodeAllocator(std::allocator<Node>()),
+				_nodeAllocator(alloc),
 				_size(0)
 			{
 				_end.color = Node::BLACK;
+				_end.count = 0;
 			}
 
 			RBTree(const RBTree &other):
 				_root(nullptr),
 				_end(value_type()),
 				_comparator(other._comparator),
-				_allocator(other._allocator),
-				_nodeAllocator(std::allocator<Node>()),
+				_allocator(alloc_traits::select_on_container_copy_construction(other._allocator)),
+				_nodeAllocator(_allocator),
 				_size(0)
 			{
-				copyTree(other.getRoot(), other.getEnd());
-				updateEndNode();
+				_end.color = Node::BLACK;
+				_end.count = 0;
+				copyTree(other);
 			}
 
 			RBTree &operator=(const RBTree &other)
 			{
 				if (this != &other)
 				{
-					deleteTree(_root);
-					copyTree(other.getRoot(), other.getEnd());
-					updateEndNode();
+					clear();
+					if (alloc_traits::propagate_on_container_copy_assignment)
+					{
+						_allocator = other._allocator;
+						_nodeAllocator = other._nodeAllocator;
+					}
+					_comparator = other._comparator;	// The nodes come in its order
+					copyTree(other);
 				}
 				return *this;
 			}
@@ -475,88 +936,215 @@ namespace ft
 			// -------------------------------------------------------------- //
 			//  Member functions                                              //
 			// -------------------------------------------------------------- //)
-			node_pointer search(const_reference data) const
+			// First element whose key is equivalent to key, nullptr if none
+			node_pointer search(const key_type &key) const
 			{
-				node_pointer current = _root;
+				prefix_type		keyPrefix = KeyPrefix::prefix(key);
+				node_pointer	bound = lowerBound(key, keyPrefix);
+
+				if (bound == &_end || keyLess(key, keyPrefix, bound))
+					return nullptr;
+				return bound;
+			}
 
-				while (current != nullptr)
+			// Most keys searched together by searchBatch()
+			static const size_type	batch_width = 32;
+
+			// Same as search() for count keys, at most batch_width, found[i]
+			// receiving the node of *keys[i]. The searches are interleaved:
+			// every round moves each unfinished one down a level and
+			// prefetches the node it reaches, which is only read on the next
+			// round. The cache misses of the whole batch are then in flight
+			// together, rather than one after the other.
+			void	searchBatch(const key_type *const *keys, size_type count, node_pointer *found) const
+			{
+				node_pointer	current[batch_width];
+				node_pointer	bound[batch_width];
+				prefix_type		keyPrefix[batch_width];
+				size_type		active[batch_width];	// Unfinished searches
+				size_type		live = 0;
+
+				for (size_type i = 0; i < count; ++i)
 				{
-					if (data == current->data)
-						return current;
-					else if (_comparator(data, current->data))
-						current = current->left;
+					keyPrefix[i] = KeyPrefix::prefix(*keys[i]);
+					current[i] = _root;
+					bound[i] = const_cast<node_pointer>(&_end);
+					if (_root != nullptr)
+						active[live++] = i;
+				}
+				while (live != 0)
+				{
+					for (size_type j = 0; j < live;)
+					{
+						size_type		i = active[j];
+						node_pointer	node = current[i];
+
+						if (keyLess(node, *keys[i], keyPrefix[i]))
+							node = node->right;
+						else
+						{
+							bound[i] = node;
+							node = node->left;
+						}
+						if (node == nullptr || node == &_end)
+						{
+							active[j] = active[--live];
+							continue ;
+						}
+#if defined(__GNUC__)
+						__builtin_prefetch(node);
+#endif
+						current[i] = node;
+						++j;
+					}
+				}
+				for (size_type i = 0; i < count; ++i)
+				{
+					if (bound[i] == &_end || keyLess(*keys[i], keyPrefix[i], bound[i]))
+						found[i] = nullptr;
 					else
-						current = current->right;
+						found[i] = bound[i];
 				}
-
-				return nullptr;
 			}
 
 			void	clear(void)
 			{
 				deleteTree(_root);
 				_root = nullptr;
+				_end.parent = nullptr;
+				resetThreads();
 				_size = 0;
 			}
 
-			ft::pair<iterator, bool>	insert(const_reference data)
+			// Exchanges the nodes in O(1), the end sentinels staying with
+			// their tree. The allocators are exchanged along, so that nodes
+			// are freed by the allocator that made them.
+			void	swap(RBTree &other)
 			{
-				node_pointer	current = _root;
-				node_pointer	parent = nullptr;
-				node_pointer	node = newNode(data);
+				if (this == &other)
+					return ;
 
 				removeEndNode();
+				other.removeEndNode();
+				swapThreads(other);
+				std::swap(_root, other._root);
+				std::swap(_size, other._size);
+				std::swap(_comparator, other._comparator);
+				std::swap(_allocator, other._allocator);
+				std::swap(_nodeAllocator, other._nodeAllocator);
+				updateEndNode();
+				other.updateEndNode();
+			}
 
-				// If the tree is empty, the new node is the root
-				if (current == nullptr)
+		private:
+			// Hangs a new node under parent, on the left when asLeft
+			iterator	insertAt(node_pointer parent, bool asLeft, const_reference data)
+			{
+				node_pointer	node = newNode(data);
+
+				removeEndNode();
+				if (parent == nullptr)
 				{
 					_root = node;
 					node->color = Node::BLACK;
-					++_size;
-					return ft::make_pair(iterator(node), true);
+					threadBefore(node, &_end);
 				}
+				else
+				{
+					if (asLeft)
+					{
+						parent->left = node;
+						threadBefore(node, parent);
+					}
+					else
+					{
+						parent->right = node;
+						threadAfter(node, parent);
+					}
+					node->parent = parent;
+					addToAncestors(parent, 1, true);
+					fixTreeInsertion(node);
+				}
+				updateEndNode();
+				++_size;
+				return iterator(node);
+			}
 
-				// Find the right place to insert the new node
-				while (current != nullptr)
+		public:
+			// Inserts data unless an element with an equivalent key is
+			// already there. A single comparison per level: the last node
+			// not greater than the key is remembered on the way down and
+			// checked for equivalence once at the bottom.
+			ft::pair<iterator, bool>	insert(const_reference data)
+			{
+				const key_type	&key = keyOf(data);
+				prefix_type		keyPrefix = KeyPrefix::prefix(key);
+				node_pointer	current = _root;
+				node_pointer	parent = nullptr;
+				node_pointer	candidate = nullptr;
+				bool			asLeft = true;
+
+				while (current != nullptr && current != &_end)
 				{
 					parent = current;
-					if (data == current->data)
-						return ft::make_pair(iterator(current), false);
-					else if (_comparator(data, current->data))
+					asLeft = keyLess(key, keyPrefix, current);
+					if (asLeft)
 						current = current->left;
 					else
+					{
+						candidate = current;
 						current = current->right;
+					}
 				}
 
-				// Insert the new node
-				if (_comparator(data, parent->data))
-					parent->left = node;
-				else
-					parent->right = node;
+				if (candidate != nullptr && !keyLess(candidate, key, keyPrefix))
+					return ft::make_pair(iterator(candidate), false);
+				return ft::make_pair(insertAt(parent, asLeft, data), true);
+			}
 
-				node->parent = parent;
+			// Inserts data even if equivalent keys are present, after them
+			iterator	insertMulti(const_reference data)
+			{
+				const key_type	&key = keyOf(data);
+				prefix_type		keyPrefix = KeyPrefix::prefix(key);
+				node_pointer	current = _root;
+				node_pointer	parent = nullptr;
+				bool			asLeft = true;
 
-				fixTreeInsertion(node);
-				updateEndNode();
-				++_size;
-				return ft::make_pair(iterator(node), true);
+				while (current != nullptr && current != &_end)
+				{
+					parent = current;
+					asLeft = keyLess(key, keyPrefix, current);
+					current = asLeft ? current->left : current->right;
+				}
+				return insertAt(parent, asLeft, data);
+			}
+
+			template <class InputIterator>
+			void	insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					insert(*first);
 			}
 
 			void	remove(iterator position)
 			{
-				node_pointer			node = &(*position);
+				node_pointer			node = position.getNode();
 				node_pointer			movedNode = nullptr;
 				node_pointer			movedParentNode = nullptr;
-				typename Node::Color	deletedColor = Node::RED;
+				typename Node::Color	deletedColor;
 
-				if (position == end())
+				if (node == nullptr || node == &_end)
 					return ;
 
 				removeEndNode();
+				unthread(node);
+
+				deletedColor = node->color;
 
 				// If node has no or one children
 				if (node->left == nullptr || node->right == nullptr)
-					movedNode = deleteWithZeroOrOneChild(node);
+					movedNode = unlinkWithZeroOrOneChild(node, &movedParentNode);
 				else
 				{
 					node_pointer	successor = node->right;
@@ -564,14 +1152,27 @@ namespace ft
 					while (successor->left != nullptr)
 						successor = successor->left;
 
-					// Swap data
-					ft::swap(node->data, successor->data);
-
-					// Delete the successor
+					// Take the successor out, then relink it in place of the
+					// node so that iterators to other elements stay valid.
 					deletedColor = successor->color;
-					movedNode = deleteWithZeroOrOneChild(successor);
+					movedNode = unlinkWithZeroOrOneChild(successor, &movedParentNode);
+					if (movedParentNode == node)
+						movedParentNode = successor;
+
+					successor->left = node->left;
+					successor->right = node->right;
+					successor->color = node->color;
+					successor->count = node->count;
+					if (successor->left != nullptr)
+						successor->left->parent = successor;
+					if (successor->right != nullptr)
+						successor->right->parent = successor;
+					replaceChildParent(node->parent, node, successor);
 				}
 
+				destroyNode(node);
+				addToAncestors(movedParentNode, 1, false);
+
 				// If the deleted node was black, we need to rebalance the tree
 				if (deletedColor == Node::BLACK)
 					fixTreeDeletion(movedNode, movedParentNode);
@@ -580,12 +1181,262 @@ namespace ft
 				--_size;
 			}
 
-			void	remove(const_reference data)
+			// Erases [first, last) in O(k + log n): the range is split out of
+			// the tree, freed, and both remaining sides are joined back on
+			// last, without any per element rebalancing.
+			void	remove(iterator first, iterator last)
 			{
-				node_pointer	node = search(data);
+				node_pointer	firstNode = first.getNode();
+				node_pointer	lastNode = last.getNode();
+				node_pointer	left, middle, right;
+				size_type		leftHeight, middleHeight, rightHeight;
+				size_type		removed;
 
-				if (node != nullptr)
-					remove(iterator(node));
+				if (first == last)
+					return ;
+
+				if (first == begin() && last == end())
+				{
+					clear();
+					return ;
+				}
+
+				removeEndNode();
+				unthreadRange(firstNode, lastNode);
+
+				splitAt(firstNode, &left, &leftHeight, &right, &rightHeight);
+				if (lastNode == &_end)
+				{
+					middle = right;
+					_root = left;
+				}
+				else
+				{
+					// last is below first's right side, split it out of there
+					_root = right;
+					splitAt(lastNode, &middle, &middleHeight, &right, &rightHeight);
+					_root = joinTrees(left, leftHeight, lastNode, right, rightHeight, &rightHeight);
+				}
+				if (_root != nullptr)
+					_root->color = Node::BLACK;
+
+				removed = destroySubtree(middle);
+				destroyNode(firstNode);
+
+				updateEndNode();
+				_size -= removed + 1;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Split / join                                                  //
+			// -------------------------------------------------------------- //
+			// Both move nodes from one tree to the other in O(log n), nothing
+			// is copied nor reallocated. The trees must share the same
+			// comparator; when their node allocators differ the elements are
+			// copied instead, a node being freed by the allocator it came from.
+
+			// Moves position and every element after it to right, whose
+			// previous content is cleared.
+			void	split(iterator position, RBTree &right)
+			{
+				node_pointer	node = position.getNode();
+				node_pointer	left, greater;
+				size_type		leftHeight, rightHeight;
+
+				if (&right == this)
+					return ;
+				right.clear();
+				if (node == nullptr || node == &_end)
+					return ;
+
+				if (!(_nodeAllocator == right._nodeAllocator))
+				{
+					for (iterator it = position; it != end(); ++it)
+						right.insertMulti(*it);
+					remove(position, end());
+					return ;
+				}
+
+				removeEndNode();
+				splitThreads(node, right);
+
+				splitAt(node, &left, &leftHeight, &greater, &rightHeight);
+				right._root = joinTrees(nullptr, 0, node, greater, rightHeight, &rightHeight);
+				right._root->color = Node::BLACK;
+				right._size = countOf(right._root);
+
+				_root = left;
+				if (_root != nullptr)
+					_root->color = Node::BLACK;
+				_size -= right._size;
+
+				updateEndNode();
+				right.updateEndNode();
+			}
+
+			// Moves every element whose key is not less than key to right
+			void	split(const key_type &key, RBTree &right)
+			{
+				split(iterator(lowerBound(key)), right);
+			}
+
+			// Moves every element of right to the end of this tree, right
+			// being left empty. When the elements of right do not all
+			// compare greater than the ones of this tree (or not less with
+			// equalKeys, for trees filled by insertMulti()), they are
+			// inserted one by one instead.
+			void	join(RBTree &right, bool equalKeys = false)
+			{
+				node_pointer	pivot;
+				node_pointer	left, greater;
+				size_type		leftHeight, rightHeight;
+				bool			adopt;
+
+				if (&right == this || right._root == nullptr)
+					return ;
+
+				// Nodes are only adopted from the same allocator, even by an
+				// empty tree, which would free them through its own
+				pivot = right.begin().getNode();
+				adopt = _nodeAllocator == right._nodeAllocator;
+
+				if (adopt && _root != nullptr)
+				{
+					const key_type	&last = keyOf(*--end());
+					const key_type	&first = keyOf(pivot->data);
+
+					adopt = equalKeys ? !keyLess(first, last) : keyLess(last, first);
+				}
+				if (!adopt)
+				{
+					for (iterator it = right.begin(); it != right.end(); ++it)
+					{
+						if (equalKeys)
+							insertMulti(*it);
+						else
+							insert(*it);
+					}
+					right.clear();
+					return ;
+				}
+
+				removeEndNode();
+				right.removeEndNode();
+				joinThreads(pivot, right);
+
+				// right's minimum is cut out to be used as the pivot
+				right.splitAt(pivot, &left, &leftHeight, &greater, &rightHeight);
+				_root = joinTrees(_root, subtreeBlackHeight(_root), pivot, greater, rightHeight, &leftHeight);
+				_root->color = Node::BLACK;
+				_size += right._size;
+
+				right._root = nullptr;
+				right._size = 0;
+
+				updateEndNode();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Order statistics                                              //
+			// -------------------------------------------------------------- //
+			// Both run in O(log n) thanks to the subtree counts.
+
+			// Index of position in the in-order sequence, size() for end()
+			size_type	rank(iterator position) const
+			{
+				const_node_pointer	node = position.getNode();
+				size_type			index;
+
+				if (node == nullptr || node == &_end)
+					return _size;
+
+				index = countOf(node->left);
+				for (; node->parent != nullptr; node = node->parent)
+					if (node->parent->right == node)
+						index += countOf(node->parent->left) + 1;
+				return index;
+			}
+
+			// Element at the given in-order index, end() when out of range
+			iterator	select(size_type index)
+			{
+				node_pointer	node = _root;
+
+				if (index >= _size)
+					return end();
+
+				while (index != countOf(node->left))
+				{
+					if (index < countOf(node->left))
+						node = node->left;
+					else
+					{
+						index -= countOf(node->left) + 1;
+						node = node->right;
+					}
+				}
+				return iterator(node);
+			}
+
+			// First node whose key is not less than key, the end sentinel if
+			// none
+			node_pointer	lowerBound(const key_type &key) const
+			{
+				return lowerBound(key, KeyPrefix::prefix(key));
+			}
+
+			node_pointer	lowerBound(const key_type &key, prefix_type keyPrefix) const
+			{
+				node_pointer	current = _root;
+				node_pointer	bound = const_cast<node_pointer>(&_end);
+
+				while (current != nullptr && current != &_end)
+				{
+					if (keyLess(current, key, keyPrefix))
+						current = current->right;
+					else
+					{
+						bound = current;
+						current = current->left;
+					}
+				}
+				return bound;
+			}
+
+			// First node whose key is greater than key, the end sentinel if
+			// none
+			node_pointer	upperBound(const key_type &key) const
+			{
+				prefix_type		keyPrefix = KeyPrefix::prefix(key);
+				node_pointer	current = _root;
+				node_pointer	bound = const_cast<node_pointer>(&_end);
+
+				while (current != nullptr && current != &_end)
+				{
+					if (keyLess(key, keyPrefix, current))
+					{
+						bound = current;
+						current = current->left;
+					}
+					else
+						current = current->right;
+				}
+				return bound;
+			}
+
+			// Removes every element whose key is equivalent to key and
+			// returns how many there were
+			size_type	remove(const key_type &key)
+			{
+				iterator	first(lowerBound(key));
+				iterator	last(upperBound(key));
+				size_type	count = rank(last) - rank(first);
+
+				if (count == 1)
+					remove(first);
+				else
+					remove(first, last);
+				return count;
 			}
 
 			node_pointer getRoot() const
@@ -608,6 +1459,38 @@ namespace ft
 				return _size;
 			}
 
+			allocator_type	get_allocator() const
+			{
+				return _allocator;
+			}
+
+			// Counters are only filled when built with FT_STATS, the shape of
+			// the tree is always reported.
+			ft::container_stats	stats() const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = _size;
+				stats.height = height(_root);
+				stats.black_height = blackHeight();
+				return stats;
+			}
+
+			// One allocation per node, the end sentinel lives in the tree
+			// object. See ft::memory_usage.
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage;
+
+				usage.payload = _size * sizeof(value_type);
+				usage.overhead = _size * (sizeof(Node) - sizeof(value_type));
+				usage.allocations = _size;
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
 			// -------------------------------------------------------------- //
 			//  Iterators                                                     //
 			// -------------------------------------------------------------- //
@@ -615,6 +1498,9 @@ namespace ft
 			{
 				node_pointer	current = _root;
 
+				if (current == nullptr)
+					return end();
+
 				while (current != nullptr && current->left != nullptr)
 					current = current->left;
 
@@ -630,6 +1516,9 @@ namespace ft
 			{
 				node_pointer	current = _root;
 
+				if (current == nullptr)
+					return end();
+
 				while (current != nullptr && current->left != nullptr)
 					current = current->left;
 
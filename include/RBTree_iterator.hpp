@@ -5,14 +5,27 @@
 namespace ft
 {
 
+	// Elements reached through a const tree are const
 	template <class Tree>
-	class RBTree_iterator: public std::iterator<std::bidirectional_iterator_tag, typename Tree::value_type>
+	struct RBTree_element
+	{
+		typedef typename Tree::value_type	type;
+	};
+
+	template <class Tree>
+	struct RBTree_element<const Tree>
+	{
+		typedef const typename Tree::value_type	type;
+	};
+
+	template <class Tree>
+	class RBTree_iterator: public std::iterator<std::bidirectional_iterator_tag, typename RBTree_element<Tree>::type>
 	{
 		private:
 			// -------------------------------------------------------------- //
 			//  Member types                                                  //
 			// -------------------------------------------------------------- //
-			typedef typename std::iterator<std::bidirectional_iterator_tag, typename Tree::value_type>	iterator_type;
+			typedef typename std::iterator<std::bidirectional_iterator_tag, typename RBTree_element<Tree>::type>	iterator_type;
 
 			typedef typename Tree::node_pointer					node_pointer;
 			typedef typename Tree::const_node_pointer			const_node_pointer;
@@ -39,6 +52,12 @@ namespace ft
 
 			RBTree_iterator(const RBTree_iterator &other): _ptr(other._ptr) {}
 
+			// --- Conversion to const_iterator --- //
+			operator RBTree_iterator<const Tree>() const
+			{
+				return RBTree_iterator<const Tree>(_ptr);
+			}
+
 			~RBTree_iterator() {}
 
 			RBTree_iterator	&operator=(const RBTree_iterator &other)
@@ -47,6 +66,12 @@ namespace ft
 				return *this;
 			}
 
+			// Node the iterator points to, used by the tree to erase in place
+			node_pointer	getNode() const
+			{
+				return _ptr;
+			}
+
 			// -------------------------------------------------------------- //
 			//  Operators                                                     //
 			// -------------------------------------------------------------- //
@@ -79,6 +104,15 @@ namespace ft
 			{
 				if (_ptr == nullptr)
 					return *this;
+#ifdef FT_THREADED_TREE
+				_ptr = _ptr->next;
+# if defined(__GNUC__)
+				// Let a range scan pull the following node in while this one
+				// is being processed.
+				if (_ptr != nullptr)
+					__builtin_prefetch(_ptr->next);
+# endif
+#else
 				if (_ptr->right != nullptr)
 				{
 					_ptr = _ptr->right;
@@ -95,6 +129,7 @@ namespace ft
 						_ptr = _ptr->parent;
 					}
 				}
+#endif
 				return *this;
 			}
 
@@ -107,10 +142,13 @@ namespace ft
 			}
 
 			// --it
-			RBTree_iterator	operator--()
+			RBTree_iterator	&operator--()
 			{
 				if (_ptr == nullptr)
 					return *this;
+#ifdef FT_THREADED_TREE
+				_ptr = _ptr->prev;
+#else
 				if (_ptr->left != nullptr)
 				{
 					_ptr = _ptr->left;
@@ -127,6 +165,7 @@ namespace ft
 						_ptr = _ptr->parent;
 					}
 				}
+#endif
 				return *this;
 			}
 
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace ft
+{
+
+	// Tells containers whether their allocator follows the elements on copy
+	// assignment, move assignment and swap, and which allocator a copy
+	// constructed container gets. Stateful allocators that must stay with
+	// their container specialize it, like ft::pmr::polymorphic_allocator.
+	template <class Alloc>
+	struct allocator_traits
+	{
+		typedef Alloc	allocator_type;
+
+		static const bool	propagate_on_container_copy_assignment = false;
+		static const bool	propagate_on_container_move_assignment = true;
+		static const bool	propagate_on_container_swap = true;
+
+		static allocator_type	select_on_container_copy_construction(const allocator_type &alloc)
+		{
+			return alloc;
+		}
+	};
+
+}
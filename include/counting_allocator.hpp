@@ -0,0 +1,173 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+
+namespace ft
+{
+
+	// -------------------------------------------------------------------------- //
+	//  Allocation counter                                                        //
+	// -------------------------------------------------------------------------- //
+	// Shared by every copy and rebind of a counting_allocator. The counts are
+	// plain integers: a counter must not be used from several threads at once.
+	struct allocation_counter
+	{
+		std::size_t		bytes;				// Bytes currently allocated
+		std::size_t		blocks;				// Blocks currently allocated
+		std::size_t		peak_bytes;			// Highest value reached by bytes
+		unsigned long	allocations;		// allocate() calls
+		unsigned long	deallocations;		// deallocate() calls
+
+		allocation_counter():
+			bytes(0),
+			blocks(0),
+			peak_bytes(0),
+			allocations(0),
+			deallocations(0)
+		{}
+
+		void	reset(void)
+		{
+			*this = allocation_counter();
+		}
+	};
+
+	// Used by default constructed counting allocators
+	inline allocation_counter	&default_allocation_counter(void)
+	{
+		static allocation_counter	counter;
+
+		return counter;
+	}
+
+	// -------------------------------------------------------------------------- //
+	//  Counting allocator                                                        //
+	// -------------------------------------------------------------------------- //
+	// Forwards to Alloc and records every allocation in a counter, so that
+	// the memory_usage() of a container can be checked against what it
+	// actually requested: once the container is the only user of the
+	// counter, counter.bytes == memory_usage().heap() and
+	// counter.blocks == memory_usage().allocations.
+	template <class T, class Alloc = std::allocator<T> >
+	class counting_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef counting_allocator<U, typename Alloc::template rebind<U>::other>	other;
+			};
+
+		private:
+			Alloc				_alloc;
+			allocation_counter	*_counter;
+
+		public:
+			counting_allocator():
+				_alloc(),
+				_counter(&default_allocation_counter())
+			{}
+
+			explicit counting_allocator(allocation_counter &counter, const Alloc &alloc = Alloc()):
+				_alloc(alloc),
+				_counter(&counter)
+			{}
+
+			counting_allocator(const counting_allocator &other):
+				_alloc(other._alloc),
+				_counter(other._counter)
+			{}
+
+			template <class U, class OtherAlloc>
+			counting_allocator(const counting_allocator<U, OtherAlloc> &other):
+				_alloc(other.upstream()),
+				_counter(&other.counter())
+			{}
+
+			counting_allocator	&operator=(const counting_allocator &other)
+			{
+				_alloc = other._alloc;
+				_counter = other._counter;
+				return *this;
+			}
+
+			pointer	allocate(size_type n, const void * = 0)
+			{
+				pointer	p = _alloc.allocate(n);
+
+				_counter->bytes += n * sizeof(T);
+				++_counter->blocks;
+				++_counter->allocations;
+				if (_counter->bytes > _counter->peak_bytes)
+					_counter->peak_bytes = _counter->bytes;
+				return p;
+			}
+
+			void	deallocate(pointer p, size_type n)
+			{
+				if (p == NULL)
+					return ;
+				_alloc.deallocate(p, n);
+				_counter->bytes -= n * sizeof(T);
+				--_counter->blocks;
+				++_counter->deallocations;
+			}
+
+			void	construct(pointer p, const_reference value)
+			{
+				_alloc.construct(p, value);
+			}
+
+			void	destroy(pointer p)
+			{
+				_alloc.destroy(p);
+			}
+
+			size_type	max_size(void) const
+			{
+				return _alloc.max_size();
+			}
+
+			pointer	address(reference x) const
+			{
+				return &x;
+			}
+
+			const_pointer	address(const_reference x) const
+			{
+				return &x;
+			}
+
+			allocation_counter	&counter(void) const
+			{
+				return *_counter;
+			}
+
+			const Alloc	&upstream(void) const
+			{
+				return _alloc;
+			}
+	};
+
+	template <class T, class AllocT, class U, class AllocU>
+	bool	operator==(const counting_allocator<T, AllocT> &lhs, const counting_allocator<U, AllocU> &rhs)
+	{
+		return &lhs.counter() == &rhs.counter() && lhs.upstream() == rhs.upstream();
+	}
+
+	template <class T, class AllocT, class U, class AllocU>
+	bool	operator!=(const counting_allocator<T, AllocT> &lhs, const counting_allocator<U, AllocU> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+}
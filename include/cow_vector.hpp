@@ -0,0 +1,604 @@
+#pragma once
+
+#include <new>
+#include <memory>
+#include <stdexcept>
+
+#include "vector.hpp"
+#include "stats.hpp"
+
+namespace ft
+{
+
+	// --- Copy-on-write vector class --- //
+	// A ft::vector whose copies share one reference counted buffer: copying
+	// or assigning a cow_vector is O(1), and the elements are only copied by
+	// the first modification made through one of the sharing copies, which
+	// then detaches with a buffer of its own. Reads through a const
+	// cow_vector (const operator[], data(), const_iterator) go straight to
+	// the buffer, without locks nor checks.
+	//
+	// Non-const element access, begin() and end() included, hands out
+	// references the vector cannot follow, so it detaches as any
+	// modification and marks the buffer unshareable: later copies take a
+	// deep copy of it, as long as those references may be alive, which is
+	// until the elements are reallocated or the buffer replaced by
+	// assign(), clear() or an assignment. Read through a const reference to
+	// keep copies cheap.
+	//
+	// Counts are updated with atomic operations when built with
+	// FT_THREAD_SAFE, so that copies sharing a buffer may live in different
+	// threads; a single cow_vector is no more thread-safe than a vector.
+	// ft::stack<T, ft::cow_vector<T> > gives stacks whose copies share too.
+	template < class T, class Allocator = std::allocator<T> >
+	class cow_vector
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef T										value_type;
+			typedef Allocator								allocator_type;
+			typedef typename Allocator::reference			reference;
+			typedef typename Allocator::const_reference		const_reference;
+			typedef typename Allocator::pointer				pointer;
+			typedef typename Allocator::const_pointer		const_pointer;
+			typedef std::ptrdiff_t							difference_type;
+			typedef std::size_t								size_type;
+
+			typedef ft::vector<T, Allocator>				vector_type;
+
+			// --- Iterator types --- //
+			typedef typename vector_type::iterator					iterator;
+			typedef typename vector_type::const_iterator			const_iterator;
+			typedef typename vector_type::reverse_iterator			reverse_iterator;
+			typedef typename vector_type::const_reverse_iterator	const_reverse_iterator;
+
+		private:
+			// Elements shared by refs cow_vectors
+			struct buffer_type
+			{
+				size_type		refs;
+				bool			shareable;	// No reference for writing handed out
+				vector_type		elements;
+
+				explicit buffer_type(const allocator_type &alloc):
+					refs(1),
+					shareable(true),
+					elements(alloc)
+				{}
+
+				explicit buffer_type(const vector_type &elements):
+					refs(1),
+					shareable(true),
+					elements(elements)
+				{}
+			};
+
+			typedef typename Allocator::template rebind<buffer_type>::other	buffer_allocator_type;
+
+			// -------------------------------------------------------------- //
+			//  Member variables                                              //
+			// -------------------------------------------------------------- //
+			allocator_type		_alloc;		// Allocator object
+			buffer_type			*_buffer;	// NULL until there are elements to hold
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			// --- Reference counting --- //
+			static void	acquire(buffer_type *buffer)
+			{
+#ifdef FT_THREAD_SAFE
+				__sync_fetch_and_add(&buffer->refs, 1);
+#else
+				++buffer->refs;
+#endif
+			}
+
+			// Drops a reference, returns the number left
+			static size_type	drop(buffer_type *buffer)
+			{
+#ifdef FT_THREAD_SAFE
+				return (__sync_sub_and_fetch(&buffer->refs, 1));
+#else
+				return (--buffer->refs);
+#endif
+			}
+
+			static size_type	refsOf(buffer_type *buffer)
+			{
+#ifdef FT_THREAD_SAFE
+				return (__sync_fetch_and_add(&buffer->refs, 0));
+#else
+				return (buffer->refs);
+#endif
+			}
+
+			// --- Buffers --- //
+			// A buffer of its own for this vector, holding a copy of source
+			// if given
+			buffer_type	*newBuffer(const vector_type *source)
+			{
+				buffer_allocator_type	bufferAllocator(_alloc);
+				buffer_type				*buffer = bufferAllocator.allocate(1);
+
+				try
+				{
+					if (source != NULL)
+						::new (static_cast<void *>(buffer)) buffer_type(*source);
+					else
+						::new (static_cast<void *>(buffer)) buffer_type(_alloc);
+				}
+				catch (...)
+				{
+					bufferAllocator.deallocate(buffer, 1);
+					throw;
+				}
+				return (buffer);
+			}
+
+			void	destroyBuffer(buffer_type *buffer)
+			{
+				buffer_allocator_type	bufferAllocator(_alloc);
+
+				bufferAllocator.destroy(buffer);
+				bufferAllocator.deallocate(buffer, 1);
+			}
+
+			void	release(void)
+			{
+				if (_buffer != NULL && drop(_buffer) == 0)
+					destroyBuffer(_buffer);
+				_buffer = NULL;
+			}
+
+			// Takes buffer in place of the current one
+			void	replace(buffer_type *buffer)
+			{
+				release();
+				_buffer = buffer;
+			}
+
+			void	share(const cow_vector &other)
+			{
+				if (other._buffer != NULL && !other._buffer->shareable)
+					_buffer = newBuffer(&other._buffer->elements);
+				else
+				{
+					_buffer = other._buffer;
+					if (_buffer != NULL)
+						acquire(_buffer);
+				}
+			}
+
+			// Elements this vector may modify, copied first if shared
+			vector_type	&unshare(void)
+			{
+				if (_buffer == NULL)
+					_buffer = newBuffer(NULL);
+				else if (refsOf(_buffer) > 1)
+					replace(newBuffer(&_buffer->elements));
+				return (_buffer->elements);
+			}
+
+			// Same as unshare(), for references that outlive the call
+			vector_type	&leak(void)
+			{
+				vector_type	&elements = unshare();
+
+				_buffer->shareable = false;
+				return (elements);
+			}
+
+			// References handed out before are gone once the elements moved
+			// away from before, copies can share the buffer again
+			void	relocated(const_pointer before)
+			{
+				if (_buffer->elements.data() != before)
+					_buffer->shareable = true;
+			}
+
+			// Index of pos, an iterator of this vector, in the buffer
+			difference_type	offsetOf(iterator pos) const
+			{
+				if (_buffer == NULL)
+					return (0);
+				return (pos - _buffer->elements.begin());
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + copying                            //
+			// -------------------------------------------------------------- //
+			// --- Default constructor --- //
+			cow_vector(void):
+				_alloc(Allocator()),
+				_buffer(NULL)
+			{}
+
+			// --- Constructor with allocator --- //
+			explicit cow_vector(const allocator_type &alloc):
+				_alloc(alloc),
+				_buffer(NULL)
+			{}
+
+			// --- Constructor with count and value --- //
+			explicit cow_vector(size_type count, const value_type &value = value_type(), const allocator_type &alloc = Allocator()):
+				_alloc(alloc),
+				_buffer(NULL)
+			{
+				assign(count, value);
+			}
+
+			// --- Constructor from iterators --- //
+			template < class InputIt >
+			cow_vector(InputIt first, InputIt last, const allocator_type &alloc = Allocator(), typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0):
+				_alloc(alloc),
+				_buffer(NULL)
+			{
+				assign(first, last);
+			}
+
+			// --- Constructor from a vector --- //
+			explicit cow_vector(const vector_type &elements):
+				_alloc(elements.get_allocator()),
+				_buffer(NULL)
+			{
+				_buffer = newBuffer(&elements);
+			}
+
+			// --- Copy constructor --- //
+			// O(1), the buffer is shared
+			cow_vector(const cow_vector &other):
+				_alloc(other._alloc),
+				_buffer(NULL)
+			{
+				share(other);
+			}
+
+			// --- Destructor --- //
+			~cow_vector(void)
+			{
+				release();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			cow_vector	&operator=(const cow_vector &other)
+			{
+				if (this == &other || _buffer == other._buffer)
+					return (*this);
+
+				cow_vector	copy(other);
+
+				swap(copy);
+				return (*this);
+			}
+
+			void	assign(size_type count, const value_type &value)
+			{
+				buffer_type	*buffer = newBuffer(NULL);
+
+				try
+				{
+					buffer->elements.assign(count, value);
+				}
+				catch (...)
+				{
+					destroyBuffer(buffer);
+					throw;
+				}
+				replace(buffer);
+			}
+
+			template < class InputIt >
+			void	assign(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				buffer_type	*buffer = newBuffer(NULL);
+
+				try
+				{
+					buffer->elements.assign(first, last);
+				}
+				catch (...)
+				{
+					destroyBuffer(buffer);
+					throw;
+				}
+				replace(buffer);
+			}
+
+			allocator_type	get_allocator(void) const
+			{
+				return (_alloc);
+			}
+
+			// Number of cow_vectors sharing the buffer, 0 without one
+			size_type	use_count(void) const
+			{
+				return (_buffer == NULL ? 0 : refsOf(_buffer));
+			}
+
+			// --- Element access --- //
+			reference at(size_type pos)
+			{
+				if (pos >= size())
+					throw std::out_of_range("cow_vector::at");
+				return (leak()[pos]);
+			}
+
+			const_reference at(size_type pos) const
+			{
+				if (pos >= size())
+					throw std::out_of_range("cow_vector::at");
+				return (_buffer->elements[pos]);
+			}
+
+			reference	operator[](size_type pos)
+			{
+				return (leak()[pos]);
+			}
+
+			const_reference	operator[](size_type pos) const
+			{
+				return (_buffer->elements[pos]);
+			}
+
+			reference	front(void)
+			{
+				return (leak().front());
+			}
+
+			const_reference	front(void) const
+			{
+				return (_buffer->elements.front());
+			}
+
+			reference	back(void)
+			{
+				return (leak().back());
+			}
+
+			const_reference	back(void) const
+			{
+				return (_buffer->elements.back());
+			}
+
+			pointer	data(void)
+			{
+				return (leak().data());
+			}
+
+			const_pointer	data(void) const
+			{
+				return (_buffer == NULL ? NULL : _buffer->elements.data());
+			}
+
+			// --- Iterators --- //
+			iterator	begin(void)
+			{
+				return (leak().begin());
+			}
+
+			const_iterator	begin(void) const
+			{
+				return (const_iterator(data()));
+			}
+
+			iterator	end(void)
+			{
+				return (leak().end());
+			}
+
+			const_iterator	end(void) const
+			{
+				return (const_iterator(data()) + size());
+			}
+
+			reverse_iterator	rbegin(void)
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin(void) const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend(void)
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend(void) const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			// --- Capacity --- //
+			size_type	size(void) const
+			{
+				return (_buffer == NULL ? 0 : _buffer->elements.size());
+			}
+
+			size_type	max_size(void) const
+			{
+				return (_alloc.max_size());
+			}
+
+			void	reserve(size_type new_cap)
+			{
+				vector_type		&elements = unshare();
+				const_pointer	before = elements.data();
+
+				elements.reserve(new_cap);
+				relocated(before);
+			}
+
+			size_type	capacity(void) const
+			{
+				return (_buffer == NULL ? 0 : _buffer->elements.capacity());
+			}
+
+			bool	empty(void) const
+			{
+				return (size() == 0);
+			}
+
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS, they follow
+			// the buffer and so are shared by its copies.
+			ft::container_stats	stats(void) const
+			{
+				if (_buffer == NULL)
+					return (ft::container_stats());
+				return (_buffer->elements.stats());
+			}
+
+			// The buffer, see ft::memory_usage. A shared buffer is counted
+			// whole by each of the vectors sharing it.
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+
+				if (_buffer != NULL)
+				{
+					usage = _buffer->elements.memory_usage();
+					usage.overhead += sizeof(buffer_type);
+					usage.allocations += 1;
+				}
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				release();
+			}
+
+			void	push_back(const value_type &value)
+			{
+				vector_type		&elements = unshare();
+				const_pointer	before = elements.data();
+
+				elements.push_back(value);
+				relocated(before);
+			}
+
+			void	pop_back(void)
+			{
+				if (!empty())
+					unshare().pop_back();
+			}
+
+			// Positions are kept as offsets, the elements may move to a buffer
+			// of their own first
+			iterator	insert(iterator pos, const value_type &value)
+			{
+				difference_type	offset = offsetOf(pos);
+				vector_type		&elements = leak();
+
+				return (elements.insert(elements.begin() + offset, value));
+			}
+
+			iterator	insert(iterator pos, size_type count, const value_type &value)
+			{
+				difference_type	offset = offsetOf(pos);
+				vector_type		&elements = leak();
+
+				return (elements.insert(elements.begin() + offset, count, value));
+			}
+
+			template < class InputIt >
+			iterator	insert(iterator pos, InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				difference_type	offset = offsetOf(pos);
+				vector_type		&elements = leak();
+
+				return (elements.insert(elements.begin() + offset, first, last));
+			}
+
+			iterator	erase(iterator pos)
+			{
+				difference_type	offset = offsetOf(pos);
+				vector_type		&elements = leak();
+
+				return (elements.erase(elements.begin() + offset));
+			}
+
+			iterator	erase(iterator first, iterator last)
+			{
+				difference_type	offset = offsetOf(first);
+				difference_type	count = last - first;
+				vector_type		&elements = leak();
+
+				return (elements.erase(elements.begin() + offset, elements.begin() + offset + count));
+			}
+
+			void	resize(size_type newSize, T value = T())
+			{
+				if (newSize == size())
+					return ;
+
+				vector_type		&elements = unshare();
+				const_pointer	before = elements.data();
+
+				elements.resize(newSize, value);
+				relocated(before);
+			}
+
+			void	swap(cow_vector &other)
+			{
+				std::swap(_alloc, other._alloc);
+				std::swap(_buffer, other._buffer);
+			}
+	};
+
+	template < class T, class Alloc >
+	bool	operator==(const cow_vector<T,Alloc>& lhs, const cow_vector<T,Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (lhs.data() == rhs.data() || ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template < class T, class Alloc >
+	bool	operator!=(const cow_vector<T,Alloc>& lhs, const cow_vector<T,Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator<(const cow_vector<T,Alloc>& lhs, const cow_vector<T,Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template < class T, class Alloc >
+	bool	operator>=(const cow_vector<T,Alloc>& lhs, const cow_vector<T,Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator<=(const cow_vector<T,Alloc>& lhs, const cow_vector<T,Alloc>& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator>(const cow_vector<T,Alloc>& lhs, const cow_vector<T,Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template < class T, class Alloc >
+	void	swap(cow_vector<T,Alloc>& lhs, cow_vector<T,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <cstddef>
+
+#include "deque.hpp"
+
+namespace ft
+{
+
+	// -------------------------------------------------------------------------- //
+	//  Deferred destruction                                                      //
+	// -------------------------------------------------------------------------- //
+	// Freeing a large container walks all of its nodes or elements, which can
+	// take hundreds of milliseconds on the thread dropping it. deferred_destroy
+	// swaps the contents into a container of its own, left to a reclaimer
+	// thread to destroy, and returns at once with the container empty.
+	//
+	// The backlog of containers waiting for the reclaimer is bounded: past
+	// set_max_backlog(), or when no thread can be started, the container is
+	// destroyed on the calling thread as usual and false is returned.
+	// Otherwise the elements' destructors and the allocator's deallocate()
+	// run on the reclaimer thread, so they must not care which thread they
+	// run on (a counting_allocator or a monotonic memory resource shared with
+	// other threads would not do), and must not throw.
+
+	// Builds the empty container the contents are swapped into. Sequences
+	// are built on the container's allocator: one that does not propagate
+	// on swap, such as a polymorphic_allocator, would otherwise turn the
+	// swap into a copy of every element. Trees, which have a key_compare,
+	// exchange their allocator with their nodes and are default built.
+	template <class Container, bool OnAllocator>
+	struct deferred_holder
+	{
+		static Container	*make(const Container &)
+		{
+			return new Container();
+		}
+	};
+
+	template <class Container>
+	struct deferred_holder<Container, true>
+	{
+		static Container	*make(const Container &container)
+		{
+			return new Container(container.get_allocator());
+		}
+	};
+
+	template <class Container>
+	struct deferred_holder_for
+	{
+		typedef char					yes;
+		typedef struct { char c[2]; }	no;
+
+		template <class U>
+		static yes	hasKeyCompare(typename U::key_compare *);
+
+		template <class U>
+		static no	hasKeyCompare(...);
+
+		template <class U>
+		static yes	hasAllocator(typename U::allocator_type *);
+
+		template <class U>
+		static no	hasAllocator(...);
+
+		static const bool	on_allocator = sizeof(hasAllocator<Container>(0)) == sizeof(yes)
+			&& sizeof(hasKeyCompare<Container>(0)) == sizeof(no);
+
+		typedef deferred_holder<Container, on_allocator>	type;
+	};
+
+	class deferred_reclaimer
+	{
+		public:
+			static const std::size_t	default_max_backlog = 16;
+
+		private:
+			// A container waiting for its destruction
+			struct job
+			{
+				void	*object;
+				void	(*destroy)(void *);
+			};
+
+			pthread_mutex_t		_mutex;
+			pthread_cond_t		_queued;	// A job was queued, or the reclaimer must stop
+			pthread_cond_t		_idle;		// Every job was done
+			ft::deque<job>		_jobs;
+			bool				_busy;		// A job is being done
+			std::size_t			_maxBacklog;
+			bool				_started;
+			bool				_stopping;
+			pthread_t			_thread;
+
+			deferred_reclaimer(const deferred_reclaimer &);
+			deferred_reclaimer	&operator=(const deferred_reclaimer &);
+
+			template <class Container>
+			static void	destroyObject(void *object)
+			{
+				delete static_cast<Container *>(object);
+			}
+
+			// Reclaimer thread, done once stopping with no job left
+			static void	*run(void *arg)
+			{
+				deferred_reclaimer	*self = static_cast<deferred_reclaimer *>(arg);
+
+#if defined(__linux__) && defined(SCHED_IDLE)
+				// Only take the time other threads leave, the backlog bound
+				// falls back on synchronous destruction if there is none
+				struct sched_param	param;
+
+				param.sched_priority = 0;
+				pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+				pthread_mutex_lock(&self->_mutex);
+				for (;;)
+				{
+					while (self->_jobs.empty() && !self->_stopping)
+						pthread_cond_wait(&self->_queued, &self->_mutex);
+					if (self->_jobs.empty())
+						break ;
+
+					job	next = self->_jobs.front();
+
+					self->_jobs.pop_front();
+					self->_busy = true;
+					pthread_mutex_unlock(&self->_mutex);
+					next.destroy(next.object);
+					pthread_mutex_lock(&self->_mutex);
+					self->_busy = false;
+					if (self->_jobs.empty())
+						pthread_cond_broadcast(&self->_idle);
+				}
+				pthread_mutex_unlock(&self->_mutex);
+				return NULL;
+			}
+
+			// Hands object to the reclaimer, false when it cannot take it
+			bool	enqueue(void *object, void (*destroy)(void *))
+			{
+				bool	queued = false;
+				job		next;
+
+				next.object = object;
+				next.destroy = destroy;
+				pthread_mutex_lock(&_mutex);
+				if (!_started && !_stopping)
+					_started = (pthread_create(&_thread, NULL, &run, this) == 0);
+				if (_started && !_stopping && _jobs.size() + _busy < _maxBacklog)
+				{
+					try
+					{
+						_jobs.push_back(next);
+						queued = true;
+						pthread_cond_signal(&_queued);
+					}
+					catch (...)
+					{}
+				}
+				pthread_mutex_unlock(&_mutex);
+				return queued;
+			}
+
+		public:
+			explicit deferred_reclaimer(std::size_t maxBacklog = default_max_backlog):
+				_busy(false),
+				_maxBacklog(maxBacklog),
+				_started(false),
+				_stopping(false)
+			{
+				pthread_mutex_init(&_mutex, NULL);
+				pthread_cond_init(&_queued, NULL);
+				pthread_cond_init(&_idle, NULL);
+			}
+
+			// Destroys what is left in the backlog before returning
+			~deferred_reclaimer()
+			{
+				pthread_mutex_lock(&_mutex);
+				_stopping = true;
+				pthread_cond_signal(&_queued);
+				pthread_mutex_unlock(&_mutex);
+				if (_started)
+					pthread_join(_thread, NULL);
+				pthread_cond_destroy(&_idle);
+				pthread_cond_destroy(&_queued);
+				pthread_mutex_destroy(&_mutex);
+			}
+
+			// Reclaimer used by ft::deferred_destroy, stopped at exit
+			static deferred_reclaimer	&instance(void)
+			{
+				static deferred_reclaimer	reclaimer;
+
+				return reclaimer;
+			}
+
+			// Empties container, its former contents being destroyed by the
+			// reclaimer thread, or right away if the backlog is full. The
+			// container must swap in O(1) with one built as above.
+			template <class Container>
+			bool	defer(Container &container)
+			{
+				Container	*doomed = deferred_holder_for<Container>::type::make(container);
+
+				doomed->swap(container);
+				if (enqueue(doomed, &destroyObject<Container>))
+					return true;
+				delete doomed;
+				return false;
+			}
+
+			// Waits until every container handed over so far is destroyed
+			void	flush(void)
+			{
+				pthread_mutex_lock(&_mutex);
+				while (!_jobs.empty() || _busy)
+					pthread_cond_wait(&_idle, &_mutex);
+				pthread_mutex_unlock(&_mutex);
+			}
+
+			// Containers handed over and not destroyed yet
+			std::size_t	backlog(void)
+			{
+				std::size_t	count;
+
+				pthread_mutex_lock(&_mutex);
+				count = _jobs.size() + _busy;
+				pthread_mutex_unlock(&_mutex);
+				return count;
+			}
+
+			void	set_max_backlog(std::size_t maxBacklog)
+			{
+				pthread_mutex_lock(&_mutex);
+				_maxBacklog = maxBacklog;
+				pthread_mutex_unlock(&_mutex);
+			}
+	};
+
+	// Destroys the contents of container on the shared reclaimer thread, see
+	// above. Returns false when they were destroyed synchronously.
+	template <class Container>
+	bool	deferred_destroy(Container &container)
+	{
+		return deferred_reclaimer::instance().defer(container);
+	}
+
+	inline void	deferred_flush(void)
+	{
+		deferred_reclaimer::instance().flush();
+	}
+
+}
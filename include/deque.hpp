@@ -0,0 +1,511 @@
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#include "iterators.hpp"
+#include "deque_iterator.hpp"
+#include "utility.hpp"
+#include "stats.hpp"
+
+namespace ft
+{
+
+	// Elements per chunk, about one page worth of them
+	template <class T>
+	struct deque_chunk_size
+	{
+		static const std::size_t	value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+	};
+
+	// --- Deque class --- //
+	// Elements live in fixed-size chunks reached through a map of chunk
+	// pointers. Growing at either end allocates at most one chunk, and when
+	// the map is full only the chunk pointers are copied: elements are never
+	// relocated and references to them stay valid until they are popped.
+	// Chunks emptied by pops are kept as spares and only given back when the
+	// map is rebuilt or the deque cleared.
+	template < class T, class Allocator = std::allocator<T> >
+	class deque: public ft::stats_policy
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef T										value_type;
+			typedef Allocator								allocator_type;
+			typedef typename Allocator::reference			reference;
+			typedef typename Allocator::const_reference		const_reference;
+			typedef typename Allocator::pointer				pointer;
+			typedef typename Allocator::const_pointer		const_pointer;
+			typedef std::ptrdiff_t							difference_type;
+			typedef std::size_t								size_type;
+
+			static const size_type	chunk_size = ft::deque_chunk_size<T>::value;
+
+			// --- Iterator types --- //
+			typedef deque_iterator<value_type, chunk_size>			iterator;
+			typedef deque_iterator<const value_type, chunk_size>	const_iterator;
+			typedef ft::reverse_iterator<iterator>					reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+		private:
+			typedef typename Allocator::template rebind<pointer>::other	map_allocator_type;
+			typedef ft::allocator_traits<Allocator>						alloc_traits;
+
+			// -------------------------------------------------------------- //
+			//  Member variables                                              //
+			// -------------------------------------------------------------- //
+			allocator_type		_alloc;		// Allocator of the chunks
+			map_allocator_type	_mapAlloc;	// Allocator of the chunk map
+			pointer				*_map;		// Chunk pointers, NULL when not allocated
+			size_type			_mapSize;	// Number of slots in the map
+			size_type			_head;		// Absolute index of the first element
+			size_type			_size;		// Number of elements
+			size_type			_chunks;	// Number of allocated chunks
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			pointer	slot(size_type index) const
+			{
+				return (_map[index / chunk_size] + index % chunk_size);
+			}
+
+			void	ensureChunk(size_type chunk)
+			{
+				if (_map[chunk] != NULL)
+					return ;
+				_map[chunk] = _alloc.allocate(chunk_size);
+				countNodeAllocation();
+				++_chunks;
+			}
+
+			void	freeChunk(size_type chunk)
+			{
+				if (_map[chunk] == NULL)
+					return ;
+				_alloc.deallocate(_map[chunk], chunk_size);
+				_map[chunk] = NULL;
+				--_chunks;
+			}
+
+			// Rebuilds the map with the used chunks centered in it, so that
+			// both ends have free slots again. The map only doubles when the
+			// used chunks fill more than half of it.
+			void	growMap(void)
+			{
+				size_type	first = _head / chunk_size;
+				size_type	used = _size == 0 ? 0 : (_head + _size - 1) / chunk_size - first + 1;
+				size_type	newSize = _mapSize;
+				size_type	newFirst;
+				pointer		*newMap;
+
+				if (newSize < 2 * (used + 1))
+					newSize = std::max<size_type>(8, _mapSize * 2);
+
+				newMap = _mapAlloc.allocate(newSize);
+				std::fill(newMap, newMap + newSize, pointer(NULL));
+				newFirst = (newSize - used) / 2;
+
+				for (size_type i = 0; i < used; ++i)
+				{
+					newMap[newFirst + i] = _map[first + i];
+					_map[first + i] = NULL;
+				}
+				for (size_type i = 0; i < _mapSize; ++i)
+					freeChunk(i);
+				if (_map != NULL)
+				{
+					_mapAlloc.deallocate(_map, _mapSize);
+					countReallocation();
+				}
+
+				_head = newFirst * chunk_size + (used == 0 ? 0 : _head % chunk_size);
+				_map = newMap;
+				_mapSize = newSize;
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + copying                            //
+			// -------------------------------------------------------------- //
+			// --- Default constructor --- //
+			deque(void):
+				_alloc(Allocator()),
+				_mapAlloc(_alloc),
+				_map(NULL),
+				_mapSize(0),
+				_head(0),
+				_size(0),
+				_chunks(0)
+			{}
+
+			// --- Constructor with allocator --- //
+			explicit deque(const allocator_type &alloc):
+				_alloc(alloc),
+				_mapAlloc(alloc),
+				_map(NULL),
+				_mapSize(0),
+				_head(0),
+				_size(0),
+				_chunks(0)
+			{}
+
+			// --- Constructor with count and value --- //
+			explicit deque(size_type count, const value_type& value = value_type(), const allocator_type& alloc = Allocator()):
+				_alloc(alloc),
+				_mapAlloc(alloc),
+				_map(NULL),
+				_mapSize(0),
+				_head(0),
+				_size(0),
+				_chunks(0)
+			{
+				assign(count, value);
+			}
+
+			// --- Constructor from iterators --- //
+			template < class InputIt >
+			deque(InputIt first, InputIt last, const allocator_type& alloc = Allocator(), typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0):
+				_alloc(alloc),
+				_mapAlloc(alloc),
+				_map(NULL),
+				_mapSize(0),
+				_head(0),
+				_size(0),
+				_chunks(0)
+			{
+				assign(first, last);
+			}
+
+			// --- Copy constructor --- //
+			deque(const deque &other):
+				_alloc(alloc_traits::select_on_container_copy_construction(other._alloc)),
+				_mapAlloc(_alloc),
+				_map(NULL),
+				_mapSize(0),
+				_head(0),
+				_size(0),
+				_chunks(0)
+			{
+				assign(other.begin(), other.end());
+			}
+
+			// --- Destructor --- //
+			~deque(void)
+			{
+				clear();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// Live elements are assigned over and the chunks are kept, like
+			// ft::vector does with its buffer.
+			deque	&operator=(const deque& other)
+			{
+				if (this == &other)
+					return (*this);
+
+				if (alloc_traits::propagate_on_container_copy_assignment)
+				{
+					// The chunks must go back to the allocator they came from
+					if (!(_alloc == other._alloc))
+						clear();
+					_alloc = other._alloc;
+					_mapAlloc = map_allocator_type(_alloc);
+				}
+
+				size_type	common = std::min(_size, other._size);
+
+				for (size_type i = 0; i < common; ++i)
+					(*this)[i] = other[i];
+				while (_size > other._size)
+					pop_back();
+				for (size_type i = common; i < other._size; ++i)
+					push_back(other[i]);
+				return (*this);
+			}
+
+			void	assign(size_type count, const value_type& value)
+			{
+				clear();
+				for (size_type i = 0; i < count; ++i)
+					push_back(value);
+			}
+
+			template < class InputIt >
+			void	assign(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				clear();
+				for (; first != last; ++first)
+					push_back(*first);
+			}
+
+			allocator_type	get_allocator(void) const
+			{
+				return (_alloc);
+			}
+
+			// --- Element access --- //
+			reference at(size_type pos)
+			{
+				if (pos >= _size)
+					throw std::out_of_range("deque::at");
+				return (*slot(_head + pos));
+			}
+
+			const_reference at(size_type pos) const
+			{
+				if (pos >= _size)
+					throw std::out_of_range("deque::at");
+				return (*slot(_head + pos));
+			}
+
+			reference	operator[](size_type pos)
+			{
+				return (*slot(_head + pos));
+			}
+
+			const_reference	operator[](size_type pos) const
+			{
+				return (*slot(_head + pos));
+			}
+
+			reference	front(void)
+			{
+				return (*slot(_head));
+			}
+
+			const_reference	front(void) const
+			{
+				return (*slot(_head));
+			}
+
+			reference	back(void)
+			{
+				return (*slot(_head + _size - 1));
+			}
+
+			const_reference	back(void) const
+			{
+				return (*slot(_head + _size - 1));
+			}
+
+			// --- Iterators --- //
+			iterator	begin(void)
+			{
+				return (iterator(_map, _head));
+			}
+
+			const_iterator	begin(void) const
+			{
+				return (const_iterator(_map, _head));
+			}
+
+			iterator	end(void)
+			{
+				return (iterator(_map, _head + _size));
+			}
+
+			const_iterator	end(void) const
+			{
+				return (const_iterator(_map, _head + _size));
+			}
+
+			reverse_iterator	rbegin(void)
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin(void) const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend(void)
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend(void) const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			// --- Capacity --- //
+			size_type	size(void) const
+			{
+				return (_size);
+			}
+
+			size_type	max_size(void) const
+			{
+				return (_alloc.max_size());
+			}
+
+			bool	empty(void) const
+			{
+				return (_size == 0);
+			}
+
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS. Node
+			// allocations count chunks, reallocations count map rebuilds.
+			ft::container_stats	stats(void) const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = _chunks * chunk_size;
+				return (stats);
+			}
+
+			// Heap bytes held by the chunks and the map, see ft::memory_usage.
+			// Spare chunks kept for reuse count as reserved space.
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+
+				usage.payload = _size * sizeof(value_type);
+				usage.overhead = _mapSize * sizeof(pointer);
+				usage.reserved = _chunks * chunk_size * sizeof(value_type) - usage.payload;
+				usage.allocations = _chunks + (_map != NULL);
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				while (_size > 0)
+					pop_back();
+				for (size_type i = 0; i < _mapSize; ++i)
+					freeChunk(i);
+				if (_map != NULL)
+					_mapAlloc.deallocate(_map, _mapSize);
+				_map = NULL;
+				_mapSize = 0;
+				_head = 0;
+			}
+
+			void	push_back(const value_type& value)
+			{
+				if (_map == NULL || (_head + _size) / chunk_size >= _mapSize)
+					growMap();
+				ensureChunk((_head + _size) / chunk_size);
+				_alloc.construct(slot(_head + _size), value);
+				++_size;
+			}
+
+			void	push_front(const value_type& value)
+			{
+				if (_map == NULL || _head == 0)
+					growMap();
+				ensureChunk((_head - 1) / chunk_size);
+				_alloc.construct(slot(_head - 1), value);
+				--_head;
+				++_size;
+			}
+
+			void	pop_back(void)
+			{
+				if (_size == 0)
+					return ;
+				_alloc.destroy(slot(_head + _size - 1));
+				--_size;
+			}
+
+			void	pop_front(void)
+			{
+				if (_size == 0)
+					return ;
+				_alloc.destroy(slot(_head));
+				++_head;
+				--_size;
+			}
+
+			void	resize(size_type newSize, T value = T())
+			{
+				while (_size > newSize)
+					pop_back();
+				while (_size < newSize)
+					push_back(value);
+			}
+
+			// Like ft::vector, the contents are copied across when the
+			// allocators neither propagate nor compare equal.
+			void	swap(deque& other)
+			{
+				if (this == &other)
+					return ;
+
+				if (alloc_traits::propagate_on_container_swap)
+				{
+					std::swap(_alloc, other._alloc);
+					std::swap(_mapAlloc, other._mapAlloc);
+				}
+				else if (!(_alloc == other._alloc))
+				{
+					deque	tmp(other.begin(), other.end(), _alloc);
+
+					other = *this;
+					*this = tmp;
+					return ;
+				}
+				std::swap(_map, other._map);
+				std::swap(_mapSize, other._mapSize);
+				std::swap(_head, other._head);
+				std::swap(_size, other._size);
+				std::swap(_chunks, other._chunks);
+			}
+	};
+
+	template < class T, class Alloc >
+	bool	operator==(const deque<T,Alloc>& lhs, const deque<T,Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template < class T, class Alloc >
+	bool	operator!=(const deque<T,Alloc>& lhs, const deque<T,Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator<(const deque<T,Alloc>& lhs, const deque<T,Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template < class T, class Alloc >
+	bool	operator>=(const deque<T,Alloc>& lhs, const deque<T,Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator<=(const deque<T,Alloc>& lhs, const deque<T,Alloc>& rhs)
+	{
+		return (lhs < rhs || lhs == rhs);
+	}
+
+	template < class T, class Alloc >
+	bool	operator>(const deque<T,Alloc>& lhs, const deque<T,Alloc>& rhs)
+	{
+		return (!(lhs <= rhs));
+	}
+
+	template < class T, class Alloc >
+	void	swap(deque<T,Alloc>& lhs, deque<T,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
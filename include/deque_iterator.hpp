@@ -0,0 +1,239 @@
+#pragma once
+
+#include <iostream>
+#include <iterator>
+#include <cstddef>
+
+namespace ft
+{
+
+	// --- Deque Iterator class --- //
+	// Walks the chunk map of a deque: the iterator only keeps the map and
+	// the absolute index of the element, the chunk and the offset in it are
+	// derived from the index.
+	template <class T, std::size_t ChunkSize>
+	class deque_iterator: public std::iterator<std::random_access_iterator_tag, T>
+	{
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::difference_type		difference_type;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::value_type			value_type;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::pointer				pointer;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::reference			reference;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::iterator_category	iterator_category;
+
+			typedef T *const	*map_pointer;
+
+		private:
+			map_pointer		_map;
+			std::size_t		_index;
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + assignment                         //
+			// -------------------------------------------------------------- //
+			deque_iterator():
+				_map(NULL),
+				_index(0)
+			{}
+
+			deque_iterator(map_pointer map, std::size_t index):
+				_map(map),
+				_index(index)
+			{}
+
+			deque_iterator(const deque_iterator &other):
+				_map(other._map),
+				_index(other._index)
+			{}
+
+			// --- Conversion to const_iterator --- //
+			operator deque_iterator<const value_type, ChunkSize>() const
+			{
+				return (deque_iterator<const value_type, ChunkSize>(_map, _index));
+			}
+
+			// --- Destructor --- //
+			~deque_iterator()
+			{}
+
+			// --- Assignment --- //
+			deque_iterator &operator=(const deque_iterator &other)
+			{
+				_map = other._map;
+				_index = other._index;
+				return (*this);
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			std::size_t	getIndex(void) const
+			{
+				return (_index);
+			}
+
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return (_map[_index / ChunkSize][_index % ChunkSize]);
+			}
+
+			pointer operator->() const
+			{
+				return (&**this);
+			}
+
+			reference operator[](difference_type n) const
+			{
+				return (*(*this + n));
+			}
+
+			// --- Increment --- //
+			deque_iterator &operator++() // ++it
+			{
+				++_index;
+				return (*this);
+			}
+
+			deque_iterator operator++(int) // it++
+			{
+				deque_iterator tmp(*this);
+				++_index;
+				return (tmp);
+			}
+
+			// --- Decrement --- //
+			deque_iterator &operator--() // --it
+			{
+				--_index;
+				return (*this);
+			}
+
+			deque_iterator operator--(int) // it--
+			{
+				deque_iterator tmp(*this);
+				--_index;
+				return (tmp);
+			}
+
+			// --- Addition --- //
+			deque_iterator operator+(difference_type n) const // it + n
+			{
+				deque_iterator tmp(*this);
+				tmp._index += n;
+				return (tmp);
+			}
+
+			deque_iterator &operator+=(difference_type n) // it += n
+			{
+				_index += n;
+				return (*this);
+			}
+
+			// --- Subtraction --- //
+			deque_iterator operator-(difference_type n) const // it - n
+			{
+				deque_iterator tmp(*this);
+				tmp._index -= n;
+				return (tmp);
+			}
+
+			deque_iterator &operator-=(difference_type n) // it -= n
+			{
+				_index -= n;
+				return (*this);
+			}
+
+			// --- Difference --- //
+			difference_type operator-(const deque_iterator &other) const // it - other
+			{
+				return (static_cast<difference_type>(_index - other._index));
+			}
+
+			// --- Comparison --- //
+			bool operator==(const deque_iterator &other) const // it == other
+			{
+				return (_index == other._index);
+			}
+
+			bool operator!=(const deque_iterator &other) const // it != other
+			{
+				return (_index != other._index);
+			}
+
+			bool operator<(const deque_iterator &other) const // it < other
+			{
+				return (_index < other._index);
+			}
+
+			bool operator<=(const deque_iterator &other) const // it <= other
+			{
+				return (_index <= other._index);
+			}
+
+			bool operator>(const deque_iterator &other) const // it > other
+			{
+				return (_index > other._index);
+			}
+
+			bool operator>=(const deque_iterator &other) const // it >= other
+			{
+				return (_index >= other._index);
+			}
+
+			friend deque_iterator operator+(difference_type n, const deque_iterator &it)
+			{
+				return (it + n);
+			}
+
+	};
+
+	// --- Mixed iterator / const_iterator operations --- //
+	template <class Left, class Right, std::size_t ChunkSize>
+	typename deque_iterator<Left, ChunkSize>::difference_type operator-(const deque_iterator<Left, ChunkSize> &left,
+		const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (static_cast<typename deque_iterator<Left, ChunkSize>::difference_type>(left.getIndex() - right.getIndex()));
+	}
+
+	template <class Left, class Right, std::size_t ChunkSize>
+	bool operator==(const deque_iterator<Left, ChunkSize> &left, const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (left.getIndex() == right.getIndex());
+	}
+
+	template <class Left, class Right, std::size_t ChunkSize>
+	bool operator!=(const deque_iterator<Left, ChunkSize> &left, const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (left.getIndex() != right.getIndex());
+	}
+
+	template <class Left, class Right, std::size_t ChunkSize>
+	bool operator<(const deque_iterator<Left, ChunkSize> &left, const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (left.getIndex() < right.getIndex());
+	}
+
+	template <class Left, class Right, std::size_t ChunkSize>
+	bool operator<=(const deque_iterator<Left, ChunkSize> &left, const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (left.getIndex() <= right.getIndex());
+	}
+
+	template <class Left, class Right, std::size_t ChunkSize>
+	bool operator>(const deque_iterator<Left, ChunkSize> &left, const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (left.getIndex() > right.getIndex());
+	}
+
+	template <class Left, class Right, std::size_t ChunkSize>
+	bool operator>=(const deque_iterator<Left, ChunkSize> &left, const deque_iterator<Right, ChunkSize> &right)
+	{
+		return (left.getIndex() >= right.getIndex());
+	}
+
+}
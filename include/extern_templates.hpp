@@ -0,0 +1,72 @@
+// Guarded by hand, it is compiled on its own into the precompiled header
+#ifndef FT_EXTERN_TEMPLATES_HPP
+# define FT_EXTERN_TEMPLATES_HPP
+
+#include <string>
+#include <functional>
+#include <memory>
+
+#include "vector.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "stack.hpp"
+
+// -------------------------------------------------------------------------- //
+//  Common instantiations                                                     //
+// -------------------------------------------------------------------------- //
+// Included in front of every translation unit by `make fast`, through its
+// precompiled header. The classes listed here are declared extern, so a
+// unit using them only emits calls; their members are compiled once, in
+// src/instantiations.cpp, which defines FT_INSTANTIATING and expands the
+// same list as explicit instantiation definitions. Types missing from the
+// list are still instantiated implicitly, as usual.
+//
+// The tree behind a map or a set and its iterators are named explicitly,
+// they would otherwise be instantiated again by every unit through the
+// container's inline functions. ft::reverse_iterator cannot be listed, an
+// explicit instantiation compiles every member, and its random access ones
+// do not compile over a tree iterator.
+
+#define FT_VECTOR_INSTANTIATION(prefix, T) \
+	prefix class ft::vector< T >;
+
+#define FT_MAP_TREE(Key, T) \
+	ft::RBTree< ft::pair< const Key, T >, std::less< Key >, \
+		std::allocator< ft::pair< const Key, T > >, ft::select_first< ft::pair< const Key, T > > >
+
+#define FT_SET_TREE(Key) \
+	ft::RBTree< Key, std::less< Key >, std::allocator< Key > >
+
+#define FT_TREE_INSTANTIATION(prefix, Tree) \
+	prefix class Tree; \
+	prefix class ft::RBTree_iterator< Tree >; \
+	prefix class ft::RBTree_iterator< const Tree >;
+
+#define FT_MAP_INSTANTIATION(prefix, Key, T) \
+	prefix class ft::map< Key, T >; \
+	FT_TREE_INSTANTIATION(prefix, FT_MAP_TREE(Key, T))
+
+#define FT_SET_INSTANTIATION(prefix, Key) \
+	prefix class ft::set< Key >; \
+	FT_TREE_INSTANTIATION(prefix, FT_SET_TREE(Key))
+
+#define FT_STACK_INSTANTIATION(prefix, T) \
+	prefix class ft::stack< T >;
+
+#define FT_COMMON_INSTANTIATIONS(prefix) \
+	FT_VECTOR_INSTANTIATION(prefix, int) \
+	FT_VECTOR_INSTANTIATION(prefix, char) \
+	FT_VECTOR_INSTANTIATION(prefix, bool) \
+	FT_VECTOR_INSTANTIATION(prefix, std::string) \
+	FT_MAP_INSTANTIATION(prefix, int, int) \
+	FT_MAP_INSTANTIATION(prefix, std::string, int) \
+	FT_MAP_INSTANTIATION(prefix, std::string, std::string) \
+	FT_SET_INSTANTIATION(prefix, int) \
+	FT_SET_INSTANTIATION(prefix, std::string) \
+	FT_STACK_INSTANTIATION(prefix, int)
+
+#ifndef FT_INSTANTIATING
+FT_COMMON_INSTANTIATIONS(extern template)
+#endif
+
+#endif
@@ -0,0 +1,440 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#include "vector.hpp"
+#include "pair.hpp"
+#include "frozen_map_iterator.hpp"
+#include "stats.hpp"
+
+namespace ft
+{
+
+	// --- Frozen array --- //
+	// Column of a frozen_map: an array of elements filled once, after
+	// reserve(), and never resized. Unlike a ft::vector it holds its
+	// elements as they are, bools included, so data() and references to
+	// them always exist.
+	template <class T, class Allocator>
+	class frozen_array
+	{
+		public:
+			typedef T				value_type;
+			typedef std::size_t		size_type;
+
+		private:
+			Allocator	_alloc;
+			T			*_ptr;
+			size_type	_size;
+			size_type	_capacity;
+
+			void	release(void)
+			{
+				while (_size != 0)
+					_alloc.destroy(_ptr + --_size);
+				if (_ptr != NULL)
+					_alloc.deallocate(_ptr, _capacity);
+				_ptr = NULL;
+				_capacity = 0;
+			}
+
+		public:
+			explicit frozen_array(const Allocator &alloc):
+				_alloc(alloc),
+				_ptr(NULL),
+				_size(0),
+				_capacity(0)
+			{}
+
+			frozen_array(const frozen_array &other):
+				_alloc(other._alloc),
+				_ptr(NULL),
+				_size(0),
+				_capacity(0)
+			{
+				reserve(other._size);
+				try
+				{
+					for (size_type i = 0; i < other._size; ++i)
+						push_back(other._ptr[i]);
+				}
+				catch (...)
+				{
+					release();
+					throw;
+				}
+			}
+
+			~frozen_array()
+			{
+				release();
+			}
+
+			frozen_array	&operator=(const frozen_array &other)
+			{
+				if (this != &other)
+				{
+					frozen_array	copy(other);
+
+					swap(copy);
+				}
+				return (*this);
+			}
+
+			void	swap(frozen_array &other)
+			{
+				std::swap(_alloc, other._alloc);
+				std::swap(_ptr, other._ptr);
+				std::swap(_size, other._size);
+				std::swap(_capacity, other._capacity);
+			}
+
+			// Room for n elements, on an empty array
+			void	reserve(size_type n)
+			{
+				if (n != 0)
+					_ptr = _alloc.allocate(n);
+				_capacity = n;
+			}
+
+			// Within the room reserved
+			void	push_back(const value_type &value)
+			{
+				_alloc.construct(_ptr + _size, value);
+				++_size;
+			}
+
+			const value_type	&operator[](size_type pos) const
+			{
+				return (_ptr[pos]);
+			}
+
+			const value_type	*data(void) const
+			{
+				return (_ptr);
+			}
+
+			size_type	size(void) const
+			{
+				return (_size);
+			}
+
+			bool	empty(void) const
+			{
+				return (_size == 0);
+			}
+
+			size_type	max_size(void) const
+			{
+				return (_alloc.max_size());
+			}
+
+			Allocator	get_allocator(void) const
+			{
+				return (_alloc);
+			}
+
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+
+				usage.payload = _size * sizeof(value_type);
+				usage.reserved = (_capacity - _size) * sizeof(value_type);
+				usage.allocations = (_capacity != 0);
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+	};
+
+	// --- Frozen map class --- //
+	// Read-only snapshot of a map, made for lookup heavy phases, see
+	// ft::map::freeze(). The keys are stored in one array in Eytzinger order,
+	// i.e. as a complete binary search tree laid out breadth first, and the
+	// values in a second array with the same layout.
+	//
+	// A lookup is a branchless descent: the comparison gives the next index
+	// instead of a jump, and the four grandchildren, which are contiguous,
+	// are prefetched two levels ahead. The first levels stay in cache across
+	// lookups, unlike the nodes of a tree scattered on the heap.
+	//
+	// Iteration is in key order. Records are read through ft::soa_reference
+	// proxies, with the key in first and the value in second.
+	template <
+		class Key,
+		class T,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<ft::pair<const Key, T> >
+	>
+	class frozen_map: public ft::stats_policy
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef ft::pair<const Key, T>						value_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef Compare										key_compare;
+			typedef Allocator									allocator_type;
+
+			typedef soa_reference<const Key, const T>			reference;
+			typedef soa_reference<const Key, const T>			const_reference;
+
+			// --- Iterator types --- //
+			typedef frozen_map_iterator<Key, T>					iterator;
+			typedef frozen_map_iterator<Key, T>					const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		private:
+			typedef typename Allocator::template rebind<Key>::other			key_allocator_type;
+			typedef typename Allocator::template rebind<T>::other			mapped_allocator_type;
+			typedef ft::pair<Key, T>										record_type;
+			typedef typename Allocator::template rebind<record_type>::other	record_allocator_type;
+
+			// -------------------------------------------------------------- //
+			//  Data members                                                  //
+			// -------------------------------------------------------------- //
+			frozen_array<Key, key_allocator_type>	_keys;		// Node k at _keys[k - 1]
+			frozen_array<T, mapped_allocator_type>	_values;	// Same layout as _keys
+			key_compare								_comp;
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			struct record_compare
+			{
+				key_compare	comp;
+
+				bool	operator()(const record_type &lhs, const record_type &rhs) const
+				{
+					return (comp(lhs.first, rhs.first));
+				}
+			};
+
+			// Lays sorted records out in Eytzinger order: the in-order walk
+			// of the implicit tree gives each index its rank.
+			void	build(const ft::vector<record_type, record_allocator_type> &sorted)
+			{
+				size_type					n = sorted.size();
+				ft::vector<size_type>		rank(n + 1);
+				size_type					i = 0;
+
+				for (size_type k = eytzinger_first(n); k != 0; k = eytzinger_next(k, n))
+					rank[k] = i++;
+				_keys.reserve(n);
+				_values.reserve(n);
+				for (size_type k = 1; k <= n; ++k)
+				{
+					_keys.push_back(sorted[rank[k]].first);
+					_values.push_back(sorted[rank[k]].second);
+				}
+			}
+
+			static void	prefetch(const void *address)
+			{
+#if defined(__GNUC__)
+				__builtin_prefetch(address);
+#else
+				(void)address;
+#endif
+			}
+
+			// Index of the first key not less than key (upper is false) or
+			// greater than key (upper is true), 0 when there is none. The
+			// descent goes right when the node is before the bound; the
+			// index then ends with one 1 per right turn taken after the last
+			// left one, stripping them and that left turn gives the answer.
+			size_type	descend(const key_type &key, bool upper) const
+			{
+				const Key	*keys = _keys.data();
+				size_type	n = _keys.size();
+				size_type	k = 1;
+				size_type	levels = 0;
+
+				while (k <= n)
+				{
+					// Grandchildren 4k to 4k + 3, clamped to stay in the array
+					prefetch(keys + std::min(4 * k, n) - 1);
+					k = 2 * k + (upper ? !_comp(key, keys[k - 1]) : _comp(keys[k - 1], key));
+					++levels;
+				}
+				countComparisons(levels);
+				return (k >> (ft::count_trailing_zeros(~k) + 1));
+			}
+
+			iterator	at_index(size_type k) const
+			{
+				return (iterator(_keys.data(), _values.data(), _keys.size(), k));
+			}
+
+			// Index of key, 0 when absent
+			size_type	find_index(const key_type &key) const
+			{
+				size_type	k = descend(key, false);
+
+				if (k != 0 && _comp(key, _keys[k - 1]))
+					return (0);
+				return (k);
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors                                                  //
+			// -------------------------------------------------------------- //
+			explicit frozen_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+				_keys(key_allocator_type(alloc)),
+				_values(mapped_allocator_type(alloc)),
+				_comp(comp)
+			{}
+
+			// Records are sorted first unless they already are, e.g. when
+			// coming from a map. Of equivalent keys, the first one is kept.
+			template <class InputIterator>
+			frozen_map(
+				InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()
+			):
+				_keys(key_allocator_type(alloc)),
+				_values(mapped_allocator_type(alloc)),
+				_comp(comp)
+			{
+				ft::vector<record_type, record_allocator_type>	sorted((record_allocator_type(alloc)));
+				record_compare									recordComp = { comp };
+
+				for (; first != last; ++first)
+					sorted.push_back(record_type((*first).first, (*first).second));
+				if (!std::is_sorted(sorted.begin(), sorted.end(), recordComp))
+					std::stable_sort(sorted.begin(), sorted.end(), recordComp);
+
+				// Drop the equivalent keys following a kept one
+				size_type	kept = 0;
+
+				for (size_type i = 0; i < sorted.size(); ++i)
+					if (kept == 0 || comp(sorted[kept - 1].first, sorted[i].first))
+						sorted[kept++] = sorted[i];
+				sorted.resize(kept);
+				build(sorted);
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return allocator_type(_keys.get_allocator());
+			}
+
+			key_compare	key_comp() const
+			{
+				return _comp;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Iterators                                                     //
+			// -------------------------------------------------------------- //
+			const_iterator begin() const
+			{
+				return at_index(eytzinger_first(_keys.size()));
+			}
+
+			const_iterator end() const
+			{
+				return at_index(0);
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return const_reverse_iterator(end());
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return const_reverse_iterator(begin());
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Lookup --- //
+			const mapped_type&	at(const key_type& key) const
+			{
+				size_type	k = find_index(key);
+
+				if (k == 0)
+					throw std::out_of_range("frozen_map::at");
+				return _values[k - 1];
+			}
+
+			const_iterator	find(const key_type& key) const
+			{
+				return at_index(find_index(key));
+			}
+
+			size_type	count(const key_type& key) const
+			{
+				return find_index(key) != 0;
+			}
+
+			const_iterator	lower_bound(const key_type& key) const
+			{
+				return at_index(descend(key, false));
+			}
+
+			const_iterator	upper_bound(const key_type& key) const
+			{
+				return at_index(descend(key, true));
+			}
+
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			// --- Capacity --- //
+			bool empty() const
+			{
+				return _keys.empty();
+			}
+
+			size_type size() const
+			{
+				return _keys.size();
+			}
+
+			size_type max_size() const
+			{
+				return std::min(_keys.max_size(), _values.max_size());
+			}
+
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS.
+			ft::container_stats	stats() const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = size();
+				stats.capacity = size();
+				return stats;
+			}
+
+			// Both arrays, see ft::memory_usage
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage = _keys.memory_usage();
+				ft::memory_usage	values = _values.memory_usage();
+
+				usage.payload += values.payload;
+				usage.reserved += values.reserved;
+				usage.allocations += values.allocations;
+				usage.object = sizeof(*this);
+				return usage;
+			}
+	};
+
+}
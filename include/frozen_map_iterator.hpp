@@ -0,0 +1,175 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+
+#include "pair.hpp"
+#include "soa_vector_iterator.hpp"
+
+namespace ft
+{
+
+	// -------------------------------------------------------------------------- //
+	//  Eytzinger layout                                                          //
+	// -------------------------------------------------------------------------- //
+	// A complete binary search tree stored breadth first in an array: the
+	// node at index k (counted from 1) has its children at 2k and 2k + 1 and
+	// its parent at k / 2. Index 0 stands for "no node". The functions below
+	// walk such a tree of n nodes in order.
+
+	// Leftmost node, 0 for an empty tree
+	inline std::size_t	eytzinger_first(std::size_t n)
+	{
+		std::size_t	k = (n != 0);
+
+		while (2 * k <= n && k != 0)
+			k = 2 * k;
+		return (k);
+	}
+
+	// Rightmost node, 0 for an empty tree
+	inline std::size_t	eytzinger_last(std::size_t n)
+	{
+		std::size_t	k = (n != 0);
+
+		while (2 * k + 1 <= n && k != 0)
+			k = 2 * k + 1;
+		return (k);
+	}
+
+	// In-order successor, 0 after the last node
+	inline std::size_t	eytzinger_next(std::size_t k, std::size_t n)
+	{
+		if (2 * k + 1 <= n)
+		{
+			k = 2 * k + 1;
+			while (2 * k <= n)
+				k = 2 * k;
+			return (k);
+		}
+		// Up past the ancestors k is a right descendant of
+		while (k & 1)
+			k >>= 1;
+		return (k >> 1);
+	}
+
+	// In-order predecessor, 0 before the first node
+	inline std::size_t	eytzinger_prev(std::size_t k, std::size_t n)
+	{
+		if (2 * k <= n && k != 0)
+		{
+			k = 2 * k;
+			while (2 * k + 1 <= n)
+				k = 2 * k + 1;
+			return (k);
+		}
+		// Up past the ancestors k is a left descendant of
+		while (k != 0 && (k & 1) == 0)
+			k >>= 1;
+		return (k >> 1);
+	}
+
+	// --- Frozen map iterator class --- //
+	// Walks the Eytzinger ordered keys and values of a ft::frozen_map in key
+	// order. Keys and values are stored apart, so records are read through
+	// ft::soa_reference proxies. Decrementing end() gives the last record.
+	template <class Key, class T>
+	class frozen_map_iterator
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef std::bidirectional_iterator_tag			iterator_category;
+			typedef ft::pair<const Key, T>					value_type;
+			typedef std::ptrdiff_t							difference_type;
+			typedef soa_reference<const Key, const T>		reference;
+			typedef soa_arrow<reference>					pointer;
+
+		private:
+			const Key	*_keys;		// Node k at _keys[k - 1]
+			const T		*_values;	// Same layout as _keys
+			std::size_t	_size;
+			std::size_t	_index;		// Eytzinger index, 0 for end()
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + assignment                         //
+			// -------------------------------------------------------------- //
+			frozen_map_iterator():
+				_keys(NULL),
+				_values(NULL),
+				_size(0),
+				_index(0)
+			{}
+
+			frozen_map_iterator(const Key *keys, const T *values, std::size_t size, std::size_t index):
+				_keys(keys),
+				_values(values),
+				_size(size),
+				_index(index)
+			{}
+
+			std::size_t	index(void) const
+			{
+				return (_index);
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return (reference(_keys[_index - 1], _values[_index - 1]));
+			}
+
+			pointer operator->() const
+			{
+				return (pointer(**this));
+			}
+
+			// --- Increment / decrement --- //
+			frozen_map_iterator &operator++() // ++it
+			{
+				if (_index != 0)
+					_index = eytzinger_next(_index, _size);
+				return (*this);
+			}
+
+			frozen_map_iterator operator++(int) // it++
+			{
+				frozen_map_iterator tmp(*this);
+				++*this;
+				return (tmp);
+			}
+
+			frozen_map_iterator &operator--() // --it
+			{
+				if (_index == 0)
+					_index = eytzinger_last(_size);
+				else
+					_index = eytzinger_prev(_index, _size);
+				return (*this);
+			}
+
+			frozen_map_iterator operator--(int) // it--
+			{
+				frozen_map_iterator tmp(*this);
+				--*this;
+				return (tmp);
+			}
+
+			// --- Comparison --- //
+			bool operator==(const frozen_map_iterator &other) const // it == other
+			{
+				return (_index == other._index && _keys == other._keys);
+			}
+
+			bool operator!=(const frozen_map_iterator &other) const // it != other
+			{
+				return (!(*this == other));
+			}
+	};
+
+}
@@ -0,0 +1,641 @@
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#include "iterators.hpp"
+#include "incremental_vector_iterator.hpp"
+#include "utility.hpp"
+#include "stats.hpp"
+
+namespace ft
+{
+
+	// --- Incremental Vector class --- //
+	// Same interface as ft::vector, but growing never copies the whole
+	// buffer at once: the old buffer stays alive next to the new one and
+	// every later modification migrates a few elements to the new buffer.
+	// Since the new buffer is twice as large, the migration always ends
+	// before it fills up, so push_back is O(1) in the worst case.
+	//
+	// While migrating, element i lives in the old buffer when
+	// _migrated <= i < _oldEnd and in the new buffer otherwise. Operations
+	// that need a contiguous buffer (data(), insert(), erase()) finish the
+	// migration first; they are O(n) anyway.
+	template < class T, class Allocator = std::allocator<T> >
+	class incremental_vector: public ft::stats_policy
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef T										value_type;
+			typedef Allocator								allocator_type;
+			typedef typename Allocator::reference			reference;
+			typedef typename Allocator::const_reference		const_reference;
+			typedef typename Allocator::pointer				pointer;
+			typedef typename Allocator::const_pointer		const_pointer;
+			typedef std::ptrdiff_t							difference_type;
+			typedef std::size_t								size_type;
+
+			// --- Iterator types --- //
+			typedef incremental_vector_iterator<incremental_vector, value_type>					iterator;
+			typedef incremental_vector_iterator<const incremental_vector, const value_type>		const_iterator;
+			typedef ft::reverse_iterator<iterator>												reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>										const_reverse_iterator;
+
+			// Least number of elements moved to the new buffer by each
+			// modification
+			static const size_type	migration_step = 2;
+
+		private:
+			typedef ft::allocator_traits<Allocator>			alloc_traits;
+
+			// -------------------------------------------------------------- //
+			//  Member variables                                              //
+			// -------------------------------------------------------------- //
+			allocator_type		_alloc;			// Allocator object
+			size_type			_size;			// Number of elements
+			size_type			_capacity;		// Capacity of the new buffer
+			pointer				_ptr;			// New buffer
+			pointer				_old;			// Old buffer, NULL when not migrating
+			size_type			_oldCapacity;	// Capacity of the old buffer
+			size_type			_oldEnd;		// End of the elements left in the old buffer
+			size_type			_migrated;		// Elements already moved to the new buffer
+			size_type			_step;			// Elements moved per modification
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			pointer	slot(size_type index) const
+			{
+				if (_old != NULL && index >= _migrated && index < _oldEnd)
+					return (_old + index);
+				return (_ptr + index);
+			}
+
+			void	releaseOld(void)
+			{
+				_alloc.deallocate(_old, _oldCapacity);
+				_old = NULL;
+				_oldCapacity = 0;
+				_oldEnd = 0;
+				_migrated = 0;
+			}
+
+			// Moves up to count elements from the old buffer to the new one
+			void	migrate(size_type count)
+			{
+				if (_old == NULL)
+					return ;
+
+				size_type	first = _migrated;
+
+				for (; count > 0 && _migrated < _oldEnd; --count, ++_migrated)
+				{
+					_alloc.construct(_ptr + _migrated, _old[_migrated]);
+					_alloc.destroy(_old + _migrated);
+				}
+				countRelocations(_migrated - first, sizeof(value_type));
+				if (_migrated >= _oldEnd)
+					releaseOld();
+			}
+
+			void	finishMigration(void)
+			{
+				if (_old != NULL)
+					migrate(_oldEnd - _migrated);
+			}
+
+			// Switches to a new buffer, the elements follow incrementally.
+			// The step is chosen so that the migration is over before the
+			// new buffer fills up, even after a reserve() with little room.
+			void	startMigration(size_type new_cap)
+			{
+				pointer		new_start;
+				size_type	room = new_cap - _size;
+
+				finishMigration();
+				new_start = _alloc.allocate(new_cap);
+				countReallocation();
+
+				if (_size == 0)
+					_alloc.deallocate(_ptr, _capacity);
+				else
+				{
+					_old = _ptr;
+					_oldCapacity = _capacity;
+					_oldEnd = _size;
+					_migrated = 0;
+					_step = std::max(migration_step, (_size + room - 1) / room);
+				}
+				_ptr = new_start;
+				_capacity = new_cap;
+			}
+
+			// Makes the buffer contiguous and large enough for new_size
+			// elements, for the operations that shift elements around.
+			void	makeContiguous(size_type new_size)
+			{
+				if (new_size > _capacity)
+					startMigration(std::max(new_size, _capacity * 2));
+				finishMigration();
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + copying                            //
+			// -------------------------------------------------------------- //
+			// --- Default constructor --- //
+			incremental_vector(void):
+				_alloc(Allocator()),
+				_size(0),
+				_capacity(0),
+				_ptr(NULL),
+				_old(NULL),
+				_oldCapacity(0),
+				_oldEnd(0),
+				_migrated(0),
+				_step(migration_step)
+			{}
+
+			// --- Constructor with allocator --- //
+			explicit incremental_vector(const allocator_type &alloc):
+				_alloc(alloc),
+				_size(0),
+				_capacity(0),
+				_ptr(NULL),
+				_old(NULL),
+				_oldCapacity(0),
+				_oldEnd(0),
+				_migrated(0),
+				_step(migration_step)
+			{}
+
+			// --- Constructor with count and value --- //
+			explicit incremental_vector(size_type count, const value_type& value = value_type(), const allocator_type& alloc = Allocator()):
+				_alloc(alloc),
+				_size(0),
+				_capacity(0),
+				_ptr(NULL),
+				_old(NULL),
+				_oldCapacity(0),
+				_oldEnd(0),
+				_migrated(0),
+				_step(migration_step)
+			{
+				assign(count, value);
+			}
+
+			// --- Constructor from iterators --- //
+			template < class InputIt >
+			incremental_vector(InputIt first, InputIt last, const allocator_type& alloc = Allocator(), typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0):
+				_alloc(alloc),
+				_size(0),
+				_capacity(0),
+				_ptr(NULL),
+				_old(NULL),
+				_oldCapacity(0),
+				_oldEnd(0),
+				_migrated(0),
+				_step(migration_step)
+			{
+				assign(first, last);
+			}
+
+			// --- Copy constructor --- //
+			incremental_vector(const incremental_vector &other):
+				_alloc(alloc_traits::select_on_container_copy_construction(other._alloc)),
+				_size(0),
+				_capacity(0),
+				_ptr(NULL),
+				_old(NULL),
+				_oldCapacity(0),
+				_oldEnd(0),
+				_migrated(0),
+				_step(migration_step)
+			{
+				*this = other;
+			}
+
+			// --- Destructor --- //
+			~incremental_vector(void)
+			{
+				clear();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// Reuses the current buffer when it is large enough, like
+			// ft::vector does.
+			incremental_vector	&operator=(const incremental_vector& other)
+			{
+				if (this == &other)
+					return (*this);
+
+				if (alloc_traits::propagate_on_container_copy_assignment)
+				{
+					// The buffers must go back to the allocator they came from
+					if (!(_alloc == other._alloc))
+						clear();
+					_alloc = other._alloc;
+				}
+
+				finishMigration();
+				if (other._size > _capacity)
+				{
+					clear();
+					_ptr = _alloc.allocate(other._size);
+					_capacity = other._size;
+					countReallocation();
+				}
+
+				size_type	common = std::min(_size, other._size);
+
+				for (size_type i = 0; i < common; ++i)
+					_ptr[i] = other[i];
+				for (size_type i = common; i < other._size; ++i)
+					_alloc.construct(_ptr + i, other[i]);
+				for (size_type i = other._size; i < _size; ++i)
+					_alloc.destroy(_ptr + i);
+				_size = other._size;
+				return (*this);
+			}
+
+			void	assign(size_type count, const value_type& value)
+			{
+				clear();
+				reserve(count);
+				for (; _size < count; ++_size)
+					_alloc.construct(_ptr + _size, value);
+			}
+
+			template < class InputIt >
+			void	assign(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				clear();
+				for (; first != last; ++first)
+					push_back(*first);
+			}
+
+			allocator_type	get_allocator(void) const
+			{
+				return (_alloc);
+			}
+
+			// --- Element access --- //
+			reference at(size_type pos)
+			{
+				if (pos >= _size)
+					throw std::out_of_range("incremental_vector::at");
+				return (*slot(pos));
+			}
+
+			const_reference at(size_type pos) const
+			{
+				if (pos >= _size)
+					throw std::out_of_range("incremental_vector::at");
+				return (*slot(pos));
+			}
+
+			reference	operator[](size_type pos)
+			{
+				return (*slot(pos));
+			}
+
+			const_reference	operator[](size_type pos) const
+			{
+				return (*slot(pos));
+			}
+
+			reference	front(void)
+			{
+				return (*slot(0));
+			}
+
+			const_reference	front(void) const
+			{
+				return (*slot(0));
+			}
+
+			reference	back(void)
+			{
+				return (*slot(_size - 1));
+			}
+
+			const_reference	back(void) const
+			{
+				return (*slot(_size - 1));
+			}
+
+			// Finishes the migration to hand out a contiguous buffer, hence
+			// there is no const overload.
+			pointer	data(void)
+			{
+				finishMigration();
+				return (_ptr);
+			}
+
+			// --- Iterators --- //
+			iterator	begin(void)
+			{
+				return (iterator(this, 0));
+			}
+
+			const_iterator	begin(void) const
+			{
+				return (const_iterator(this, 0));
+			}
+
+			iterator	end(void)
+			{
+				return (iterator(this, _size));
+			}
+
+			const_iterator	end(void) const
+			{
+				return (const_iterator(this, _size));
+			}
+
+			reverse_iterator	rbegin(void)
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin(void) const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend(void)
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend(void) const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			// --- Capacity --- //
+			size_type	size(void) const
+			{
+				return (_size);
+			}
+
+			size_type	max_size(void) const
+			{
+				return (_alloc.max_size());
+			}
+
+			// Only allocates, the elements are moved by later modifications
+			void	reserve(size_type new_cap)
+			{
+				if (new_cap <= _capacity)
+					return ;
+
+				if (new_cap > max_size())
+					throw std::length_error("incremental_vector::reserve");
+				startMigration(new_cap);
+			}
+
+			size_type	capacity(void) const
+			{
+				return (_capacity);
+			}
+
+			bool	empty(void) const
+			{
+				return (_size == 0);
+			}
+
+			// Whether elements are still left in the old buffer
+			bool	migrating(void) const
+			{
+				return (_old != NULL);
+			}
+
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS.
+			ft::container_stats	stats(void) const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = _capacity;
+				return (stats);
+			}
+
+			// Heap bytes held by the buffers, see ft::memory_usage. While
+			// migrating, the old buffer counts as reserved space.
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+				size_type			slots = _capacity + (_old != NULL ? _oldCapacity : 0);
+
+				usage.payload = _size * sizeof(value_type);
+				usage.reserved = slots * sizeof(value_type) - usage.payload;
+				usage.allocations = (_capacity != 0) + (_old != NULL);
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				for (size_type i = 0; i < _size; ++i)
+					_alloc.destroy(slot(i));
+				if (_old != NULL)
+					releaseOld();
+				_alloc.deallocate(_ptr, _capacity);
+				_size = 0;
+				_ptr = NULL;
+				_capacity = 0;
+			}
+
+			void	push_back(const value_type& value)
+			{
+				if (_size >= _capacity)
+					startMigration(std::max<size_type>(1, _capacity * 2));
+				_alloc.construct(_ptr + _size, value);
+				++_size;
+				migrate(_step);
+			}
+
+			void	pop_back(void)
+			{
+				if (_size == 0)
+					return ;
+				--_size;
+				_alloc.destroy(slot(_size));
+				if (_old != NULL && _size < _oldEnd)
+					_oldEnd = _size;
+				migrate(_step);
+			}
+
+			iterator	insert(iterator pos, const value_type& value)
+			{
+				return (insert(pos, 1, value));
+			}
+
+			// The value is copied first, it may be one of the elements moved
+			// or freed with the old buffer
+			iterator	insert(iterator pos, size_type count, const value_type& value)
+			{
+				size_type	index = pos - begin();
+				value_type	copy(value);
+
+				makeContiguous(_size + count);
+				for (size_type i = _size; i > index; --i)
+				{
+					if (i - 1 + count >= _size)
+						_alloc.construct(_ptr + i - 1 + count, _ptr[i - 1]);
+					else
+						_ptr[i - 1 + count] = _ptr[i - 1];
+				}
+				for (size_type i = index; i < index + count; ++i)
+				{
+					if (i >= _size)
+						_alloc.construct(_ptr + i, copy);
+					else
+						_ptr[i] = copy;
+				}
+				_size += count;
+				return (begin() + index);
+			}
+
+			// The range is copied first, for the same reason
+			template < class InputIt >
+			iterator	insert(iterator pos, InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				size_type			index = pos - begin();
+				incremental_vector	range(first, last, _alloc);
+				size_type			count = range.size();
+				iterator			source = range.begin();
+
+				makeContiguous(_size + count);
+				for (size_type i = _size; i > index; --i)
+				{
+					if (i - 1 + count >= _size)
+						_alloc.construct(_ptr + i - 1 + count, _ptr[i - 1]);
+					else
+						_ptr[i - 1 + count] = _ptr[i - 1];
+				}
+				for (size_type i = index; i < index + count; ++i, ++source)
+				{
+					if (i >= _size)
+						_alloc.construct(_ptr + i, *source);
+					else
+						_ptr[i] = *source;
+				}
+				_size += count;
+				return (begin() + index);
+			}
+
+			iterator	erase(iterator pos)
+			{
+				return (erase(pos, pos + 1));
+			}
+
+			iterator	erase(iterator first, iterator last)
+			{
+				size_type	index = first - begin();
+				size_type	count = last - first;
+
+				if (count == 0)
+					return (first);
+				finishMigration();
+				std::copy(_ptr + index + count, _ptr + _size, _ptr + index);
+				for (size_type i = _size - count; i < _size; ++i)
+					_alloc.destroy(_ptr + i);
+				_size -= count;
+				return (begin() + index);
+			}
+
+			void	resize(size_type newSize, T value = T())
+			{
+				while (_size > newSize)
+					pop_back();
+				while (_size < newSize)
+					push_back(value);
+			}
+
+			// Like ft::vector, the contents are copied across when the
+			// allocators neither propagate nor compare equal.
+			void	swap(incremental_vector& other)
+			{
+				if (this == &other)
+					return ;
+
+				if (alloc_traits::propagate_on_container_swap)
+					std::swap(_alloc, other._alloc);
+				else if (!(_alloc == other._alloc))
+				{
+					incremental_vector	tmp(other.begin(), other.end(), _alloc);
+
+					other = *this;
+					*this = tmp;
+					return ;
+				}
+				std::swap(_size, other._size);
+				std::swap(_capacity, other._capacity);
+				std::swap(_ptr, other._ptr);
+				std::swap(_old, other._old);
+				std::swap(_oldCapacity, other._oldCapacity);
+				std::swap(_oldEnd, other._oldEnd);
+				std::swap(_migrated, other._migrated);
+				std::swap(_step, other._step);
+			}
+	};
+
+	template < class T, class Allocator >
+	const typename incremental_vector<T, Allocator>::size_type	incremental_vector<T, Allocator>::migration_step;
+
+	template < class T, class Alloc >
+	bool	operator==(const incremental_vector<T,Alloc>& lhs, const incremental_vector<T,Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template < class T, class Alloc >
+	bool	operator!=(const incremental_vector<T,Alloc>& lhs, const incremental_vector<T,Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator<(const incremental_vector<T,Alloc>& lhs, const incremental_vector<T,Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template < class T, class Alloc >
+	bool	operator>=(const incremental_vector<T,Alloc>& lhs, const incremental_vector<T,Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template < class T, class Alloc >
+	bool	operator<=(const incremental_vector<T,Alloc>& lhs, const incremental_vector<T,Alloc>& rhs)
+	{
+		return (lhs < rhs || lhs == rhs);
+	}
+
+	template < class T, class Alloc >
+	bool	operator>(const incremental_vector<T,Alloc>& lhs, const incremental_vector<T,Alloc>& rhs)
+	{
+		return (!(lhs <= rhs));
+	}
+
+	template < class T, class Alloc >
+	void	swap(incremental_vector<T,Alloc>& lhs, incremental_vector<T,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
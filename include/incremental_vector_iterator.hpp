@@ -0,0 +1,237 @@
+#pragma once
+
+#include <iostream>
+#include <iterator>
+#include <cstddef>
+
+namespace ft
+{
+
+	// --- Incremental Vector Iterator class --- //
+	// Elements may sit in either of two buffers while the vector migrates,
+	// so the iterator keeps the container and an index and goes through
+	// operator[].
+	template <class Container, class T>
+	class incremental_vector_iterator: public std::iterator<std::random_access_iterator_tag, T>
+	{
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::difference_type		difference_type;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::value_type			value_type;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::pointer				pointer;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::reference			reference;
+			typedef typename std::iterator<std::random_access_iterator_tag, T>::iterator_category	iterator_category;
+
+		private:
+			Container		*_container;
+			std::size_t		_index;
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + assignment                         //
+			// -------------------------------------------------------------- //
+			incremental_vector_iterator():
+				_container(NULL),
+				_index(0)
+			{}
+
+			incremental_vector_iterator(Container *container, std::size_t index):
+				_container(container),
+				_index(index)
+			{}
+
+			incremental_vector_iterator(const incremental_vector_iterator &other):
+				_container(other._container),
+				_index(other._index)
+			{}
+
+			// --- Conversion to const_iterator --- //
+			operator incremental_vector_iterator<const Container, const value_type>() const
+			{
+				return (incremental_vector_iterator<const Container, const value_type>(_container, _index));
+			}
+
+			// --- Destructor --- //
+			~incremental_vector_iterator()
+			{}
+
+			// --- Assignment --- //
+			incremental_vector_iterator &operator=(const incremental_vector_iterator &other)
+			{
+				_container = other._container;
+				_index = other._index;
+				return (*this);
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			std::size_t	getIndex(void) const
+			{
+				return (_index);
+			}
+
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return ((*_container)[_index]);
+			}
+
+			pointer operator->() const
+			{
+				return (&**this);
+			}
+
+			reference operator[](difference_type n) const
+			{
+				return (*(*this + n));
+			}
+
+			// --- Increment --- //
+			incremental_vector_iterator &operator++() // ++it
+			{
+				++_index;
+				return (*this);
+			}
+
+			incremental_vector_iterator operator++(int) // it++
+			{
+				incremental_vector_iterator tmp(*this);
+				++_index;
+				return (tmp);
+			}
+
+			// --- Decrement --- //
+			incremental_vector_iterator &operator--() // --it
+			{
+				--_index;
+				return (*this);
+			}
+
+			incremental_vector_iterator operator--(int) // it--
+			{
+				incremental_vector_iterator tmp(*this);
+				--_index;
+				return (tmp);
+			}
+
+			// --- Addition --- //
+			incremental_vector_iterator operator+(difference_type n) const // it + n
+			{
+				incremental_vector_iterator tmp(*this);
+				tmp._index += n;
+				return (tmp);
+			}
+
+			incremental_vector_iterator &operator+=(difference_type n) // it += n
+			{
+				_index += n;
+				return (*this);
+			}
+
+			// --- Subtraction --- //
+			incremental_vector_iterator operator-(difference_type n) const // it - n
+			{
+				incremental_vector_iterator tmp(*this);
+				tmp._index -= n;
+				return (tmp);
+			}
+
+			incremental_vector_iterator &operator-=(difference_type n) // it -= n
+			{
+				_index -= n;
+				return (*this);
+			}
+
+			// --- Difference --- //
+			difference_type operator-(const incremental_vector_iterator &other) const // it - other
+			{
+				return (static_cast<difference_type>(_index - other._index));
+			}
+
+			// --- Comparison --- //
+			bool operator==(const incremental_vector_iterator &other) const // it == other
+			{
+				return (_index == other._index);
+			}
+
+			bool operator!=(const incremental_vector_iterator &other) const // it != other
+			{
+				return (_index != other._index);
+			}
+
+			bool operator<(const incremental_vector_iterator &other) const // it < other
+			{
+				return (_index < other._index);
+			}
+
+			bool operator<=(const incremental_vector_iterator &other) const // it <= other
+			{
+				return (_index <= other._index);
+			}
+
+			bool operator>(const incremental_vector_iterator &other) const // it > other
+			{
+				return (_index > other._index);
+			}
+
+			bool operator>=(const incremental_vector_iterator &other) const // it >= other
+			{
+				return (_index >= other._index);
+			}
+
+			friend incremental_vector_iterator operator+(difference_type n, const incremental_vector_iterator &it)
+			{
+				return (it + n);
+			}
+
+	};
+
+	// --- Mixed iterator / const_iterator operations --- //
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	typename incremental_vector_iterator<ContainerLeft, Left>::difference_type operator-(const incremental_vector_iterator<ContainerLeft, Left> &left,
+		const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (static_cast<typename incremental_vector_iterator<ContainerLeft, Left>::difference_type>(left.getIndex() - right.getIndex()));
+	}
+
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	bool operator==(const incremental_vector_iterator<ContainerLeft, Left> &left, const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (left.getIndex() == right.getIndex());
+	}
+
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	bool operator!=(const incremental_vector_iterator<ContainerLeft, Left> &left, const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (left.getIndex() != right.getIndex());
+	}
+
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	bool operator<(const incremental_vector_iterator<ContainerLeft, Left> &left, const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (left.getIndex() < right.getIndex());
+	}
+
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	bool operator<=(const incremental_vector_iterator<ContainerLeft, Left> &left, const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (left.getIndex() <= right.getIndex());
+	}
+
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	bool operator>(const incremental_vector_iterator<ContainerLeft, Left> &left, const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (left.getIndex() > right.getIndex());
+	}
+
+	template <class ContainerLeft, class Left, class ContainerRight, class Right>
+	bool operator>=(const incremental_vector_iterator<ContainerLeft, Left> &left, const incremental_vector_iterator<ContainerRight, Right> &right)
+	{
+		return (left.getIndex() >= right.getIndex());
+	}
+
+}
@@ -0,0 +1,402 @@
+#pragma once
+
+#include <functional>
+
+#include "RBTree.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft
+{
+
+	// Orders intervals by start, then by end
+	template <class Key, class Compare>
+	struct interval_compare
+	{
+		Compare	comp;
+
+		interval_compare(const Compare& c = Compare()): comp(c) {}
+
+		bool operator()(const ft::pair<Key, Key>& x, const ft::pair<Key, Key>& y) const
+		{
+			return comp(x.first, y.first) || (!comp(y.first, x.first) && comp(x.second, y.second));
+		}
+	};
+
+	// Every node knows the greatest interval end of its subtree, so that
+	// whole subtrees ending before a query can be skipped.
+	template <class Key>
+	struct interval_max_end
+	{
+		struct node_base
+		{
+			Key	maxEnd;
+		};
+
+		template <class Node, class IntervalCompare>
+		static void	update(Node &node, const Node *left, const Node *right, const IntervalCompare &comp)
+		{
+			const Key	*end = &node.data.first.second;
+
+			if (left != NULL && comp.comp(*end, left->maxEnd))
+				end = &left->maxEnd;
+			if (right != NULL && comp.comp(*end, right->maxEnd))
+				end = &right->maxEnd;
+			node.maxEnd = *end;
+		}
+	};
+
+	// Maps half-open intervals [first, second) to values. Intervals may
+	// overlap and the same interval may be inserted several times, they are
+	// ordered by start then end. A start is expected to be less than its
+	// end.
+	template <
+		class Key,
+		class T,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<ft::pair<const ft::pair<Key, Key>, T> >
+	>
+	class interval_map
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef ft::pair<Key, Key>							key_type;
+			typedef T											mapped_type;
+			typedef ft::pair<const key_type, T>					value_type;
+			typedef Key											point_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef Compare										point_compare;
+			typedef ft::interval_compare<Key, Compare>			key_compare;
+			typedef Allocator									allocator_type;
+
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+
+		private:
+			typedef ft::RBTree<value_type, key_compare, allocator_type,
+				ft::select_first<value_type>, ft::interval_max_end<Key> >	tree_type;
+			typedef typename tree_type::node_pointer						node_pointer;
+
+		public:
+			// --- Iterator types --- //
+			typedef typename tree_type::iterator				iterator;
+			typedef typename tree_type::const_iterator			const_iterator;
+			typedef typename tree_type::reverse_iterator		reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator	const_reverse_iterator;
+
+		private:
+			// -------------------------------------------------------------- //
+			//  Data members                                                  //
+			// -------------------------------------------------------------- //
+			tree_type		_tree;
+			allocator_type	_alloc;
+			point_compare	_comp;
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			bool	_isNode(node_pointer node) const
+			{
+				return node != nullptr && node != _tree.getEnd();
+			}
+
+			// In-order walk reporting the intervals ending after lo and
+			// starting before hi (or at hi when closed). Subtrees ending at
+			// or before lo are skipped thanks to maxEnd, and the walk stops
+			// at the first start past hi.
+			template <class Iterator>
+			void	_collect(node_pointer node, const point_type& lo, const point_type& hi, bool closed,
+				ft::vector<Iterator>& found) const
+			{
+				if (!_isNode(node) || !_comp(lo, node->maxEnd))
+					return ;
+
+				const key_type	&interval = node->data.first;
+
+				_collect(node->left, lo, hi, closed, found);
+				if (closed ? _comp(hi, interval.first) : !_comp(interval.first, hi))
+					return ;
+				if (_comp(lo, interval.second))
+					found.push_back(Iterator(node));
+				_collect(node->right, lo, hi, closed, found);
+			}
+
+			// When the left subtree ends after lo but holds no overlap, its
+			// intervals all start at or after hi, and so do the node and its
+			// right subtree: the search never has to backtrack.
+			node_pointer	_firstOverlapping(const point_type& lo, const point_type& hi) const
+			{
+				node_pointer	node = _tree.getRoot();
+
+				while (_isNode(node))
+				{
+					const key_type	&interval = node->data.first;
+
+					if (_isNode(node->left) && _comp(lo, node->left->maxEnd))
+						node = node->left;
+					else if (!_comp(interval.first, hi))
+						break ;
+					else if (_comp(lo, interval.second))
+						return node;
+					else
+						node = node->right;
+				}
+				return const_cast<node_pointer>(_tree.getEnd());
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors                                                  //
+			// -------------------------------------------------------------- //
+			explicit interval_map(const point_compare& comp = point_compare(), const allocator_type& alloc = allocator_type()):
+				_tree(key_compare(comp), alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{}
+
+			template <class InputIterator>
+			interval_map(
+				InputIterator first,
+				InputIterator last,
+				const point_compare& comp = point_compare(),
+				const allocator_type& alloc = allocator_type()
+			):
+				_tree(key_compare(comp), alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{
+				insert(first, last);
+			}
+
+			interval_map(const interval_map& x):
+				_tree(x._tree),
+				_alloc(_tree.get_allocator()),
+				_comp(x._comp)
+			{}
+
+			interval_map& operator=(const interval_map& x)
+			{
+				_tree = x._tree;
+				_alloc = _tree.get_allocator();
+				_comp = x._comp;
+				return *this;
+			}
+
+			// --- Destructor --- //
+			~interval_map()
+			{}
+
+			allocator_type	get_allocator() const
+			{
+				return _alloc;
+			}
+
+			key_compare	key_comp() const
+			{
+				return key_compare(_comp);
+			}
+
+			point_compare	point_comp() const
+			{
+				return _comp;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Iterators                                                     //
+			// -------------------------------------------------------------- //
+			iterator begin()
+			{
+				return _tree.begin();
+			}
+
+			const_iterator begin() const
+			{
+				return _tree.begin();
+			}
+
+			iterator end()
+			{
+				return _tree.end();
+			}
+
+			const_iterator end() const
+			{
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin()
+			{
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend()
+			{
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return _tree.rend();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Capacity --- //
+			bool empty() const
+			{
+				return _tree.getRoot() == nullptr;
+			}
+
+			size_type size() const
+			{
+				return _tree.size();
+			}
+
+			size_type max_size() const
+			{
+				return _alloc.max_size();
+			}
+
+			// --- Statistics --- //
+			ft::container_stats	stats() const
+			{
+				return _tree.stats();
+			}
+
+			void	reset_stats()
+			{
+				_tree.reset_stats();
+			}
+
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage = _tree.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				_tree.clear();
+			}
+
+			iterator	insert(const value_type& val)
+			{
+				return _tree.insertMulti(val);
+			}
+
+			iterator	insert(const point_type& start, const point_type& end, const mapped_type& val)
+			{
+				return _tree.insertMulti(value_type(key_type(start, end), val));
+			}
+
+			template <class InputIterator>
+			void	insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					_tree.insertMulti(*first);
+			}
+
+			void	erase(iterator pos)
+			{
+				_tree.remove(pos);
+			}
+
+			// Erases every copy of the interval
+			size_type	erase(const key_type& interval)
+			{
+				return _tree.remove(interval);
+			}
+
+			// O(k + log n) for k erased elements, see RBTree::remove
+			void	erase(iterator first, iterator last)
+			{
+				_tree.remove(first, last);
+			}
+
+			// --- Lookup --- //
+			iterator	find(const key_type& interval)
+			{
+				node_pointer	node = _tree.search(interval);
+
+				return node == nullptr ? end() : iterator(node);
+			}
+
+			const_iterator	find(const key_type& interval) const
+			{
+				node_pointer	node = _tree.search(interval);
+
+				return node == nullptr ? end() : const_iterator(node);
+			}
+
+			// --- Interval queries --- //
+			// An interval [start, end) overlaps [lo, hi) when start < hi and
+			// lo < end. Results come in interval order.
+
+			// First overlapping interval, end() if none, in O(log n)
+			iterator	first_overlapping(const point_type& lo, const point_type& hi)
+			{
+				return iterator(_firstOverlapping(lo, hi));
+			}
+
+			const_iterator	first_overlapping(const point_type& lo, const point_type& hi) const
+			{
+				return const_iterator(_firstOverlapping(lo, hi));
+			}
+
+			bool	overlaps(const point_type& lo, const point_type& hi) const
+			{
+				return _firstOverlapping(lo, hi) != _tree.getEnd();
+			}
+
+			// Every overlapping interval, in O(min(n, (k + 1) log n)) for k
+			// results
+			ft::vector<iterator>	overlapping(const point_type& lo, const point_type& hi)
+			{
+				ft::vector<iterator>	found;
+
+				_collect(_tree.getRoot(), lo, hi, false, found);
+				return found;
+			}
+
+			ft::vector<const_iterator>	overlapping(const point_type& lo, const point_type& hi) const
+			{
+				ft::vector<const_iterator>	found;
+
+				_collect(_tree.getRoot(), lo, hi, false, found);
+				return found;
+			}
+
+			// Every interval holding point, start <= point < end
+			ft::vector<iterator>	stabbing(const point_type& point)
+			{
+				ft::vector<iterator>	found;
+
+				_collect(_tree.getRoot(), point, point, true, found);
+				return found;
+			}
+
+			ft::vector<const_iterator>	stabbing(const point_type& point) const
+			{
+				ft::vector<const_iterator>	found;
+
+				_collect(_tree.getRoot(), point, point, true, found);
+				return found;
+			}
+
+	};
+
+}
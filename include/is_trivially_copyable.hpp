@@ -0,0 +1,23 @@
+#pragma once
+
+#include "is_integral.hpp"
+
+namespace ft
+{
+
+	// True when T can be copied as raw bytes with memcpy, which implies a
+	// trivial destructor too. Only the compiler knows it for class types;
+	// without its builtin, only the integral types are reported.
+	template <class T>
+	struct is_trivially_copyable
+	{
+		typedef bool		value_type;
+#if defined(__GNUC__) || defined(__clang__)
+		static const bool	value = __is_trivially_copyable(T);
+#else
+		static const bool	value = ft::is_integral<T>::value;
+#endif
+		operator bool() const { return value; }
+	};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace ft
+{
+
+	// Key extractors telling ft::RBTree which part of an element is
+	// compared, so that lookups only need a key.
+
+	// The element is its own key, as in a set
+	template <class T>
+	struct identity
+	{
+		typedef T	key_type;
+
+		const key_type	&operator()(const T& value) const
+		{
+			return value;
+		}
+	};
+
+	// The key is the first member of a pair, as in a map
+	template <class Pair>
+	struct select_first
+	{
+		typedef typename Pair::first_type	key_type;
+
+		const key_type	&operator()(const Pair& value) const
+		{
+			return value.first;
+		}
+	};
+
+}
@@ -4,6 +4,8 @@
 
 #include "RBTree.hpp"
 #include "utility.hpp"
+#include "vector.hpp"
+#include "frozen_map.hpp"
 
 namespace ft
 {
@@ -57,7 +59,8 @@ namespace ft
 			};
 
 		private:
-			typedef ft::RBTree<value_type, value_compare, allocator_type>	tree_type;
+			// Only the keys are compared
+			typedef ft::RBTree<value_type, key_compare, allocator_type, ft::select_first<value_type> >	tree_type;
 
 		public:
 			// --- Iterator types --- //
@@ -77,20 +80,38 @@ namespace ft
 			// -------------------------------------------------------------- //
 			//  Private member functions                                      //
 			// -------------------------------------------------------------- //
+			typename tree_type::node_pointer	_findNode(const key_type& key) const
+			{
+				return _tree.search(key);
+			}
+
 			value_type*	_findPair(const key_type& key) const
 			{
-				typename tree_type::node_pointer	node = _tree.getRoot();
+				typename tree_type::node_pointer	node = _findNode(key);
+
+				if (node == nullptr)
+					return nullptr;
+				return &node->data;
+			}
+
+			// Feeds the keys to RBTree::searchBatch() batch_width at a time
+			template <class Iterator, class ForwardIterator, class OutputIterator>
+			OutputIterator	_findBatch(ForwardIterator first, ForwardIterator last, OutputIterator out, Iterator notFound) const
+			{
+				const key_type						*keys[tree_type::batch_width];
+				typename tree_type::node_pointer	found[tree_type::batch_width];
 
-				while (node)
+				while (first != last)
 				{
-					if (key == node->data.first)
-						return &node->data;
-					else if (_comp(key, node->data.first))
-						node = node->left;
-					else
-						node = node->right;
+					size_type	count = 0;
+
+					for (; first != last && count < tree_type::batch_width; ++first)
+						keys[count++] = &*first;
+					_tree.searchBatch(keys, count, found);
+					for (size_type i = 0; i < count; ++i, ++out)
+						*out = found[i] == nullptr ? notFound : Iterator(found[i]);
 				}
-				return nullptr;
+				return out;
 			}
 
 		public:
@@ -119,14 +140,14 @@ namespace ft
 
 			map(const map& x):
 				_tree(x._tree),
-				_alloc(x._alloc),
+				_alloc(_tree.get_allocator()),
 				_comp(x._comp)
 			{}
 
 			map& operator=(const map& x)
 			{
 				_tree = x._tree;
-				_alloc = x._alloc;
+				_alloc = _tree.get_allocator();
 				_comp = x._comp;
 				return *this;
 			}
@@ -214,6 +235,38 @@ namespace ft
 				return pair->second;
 			}
 
+			// --- Lookup --- //
+			iterator	find(const key_type& key)
+			{
+				typename tree_type::node_pointer	node = _findNode(key);
+
+				return node == nullptr ? end() : iterator(node);
+			}
+
+			const_iterator	find(const key_type& key) const
+			{
+				typename tree_type::node_pointer	node = _findNode(key);
+
+				return node == nullptr ? end() : const_iterator(node);
+			}
+
+			// Writes find(key) to out for every key of [first, last), in
+			// order, and returns the end of the output. The searches run
+			// interleaved, so that their cache misses overlap, see
+			// RBTree::searchBatch(). The keys must be lvalues, as given by
+			// pointers or container iterators.
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator	find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out)
+			{
+				return _findBatch(first, last, out, end());
+			}
+
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator	find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const
+			{
+				return _findBatch(first, last, out, end());
+			}
+
 			// --- Capacity --- //
 			bool empty() const
 			{
@@ -230,17 +283,442 @@ namespace ft
 				return _alloc.max_size();
 			}
 
+			// --- Statistics --- //
+			ft::container_stats	stats() const
+			{
+				return _tree.stats();
+			}
+
+			void	reset_stats()
+			{
+				_tree.reset_stats();
+			}
+
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage = _tree.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
 			// --- Modifiers --- //
 			void	clear(void)
 			{
 				_tree.clear();
 			}
 
+			void	swap(map& other)
+			{
+				_tree.swap(other._tree);
+				std::swap(_alloc, other._alloc);
+				std::swap(_comp, other._comp);
+			}
+
 			ft::pair<iterator, bool> insert(const value_type& val)
 			{
 				return _tree.insert(val);
 			}
 
+			void	erase(iterator pos)
+			{
+				_tree.remove(pos);
+			}
+
+			size_type	erase(const key_type& key)
+			{
+				typename tree_type::node_pointer	node = _findNode(key);
+
+				if (node == nullptr)
+					return 0;
+				_tree.remove(iterator(node));
+				return 1;
+			}
+
+			// O(k + log n) for k erased elements, see RBTree::remove
+			void	erase(iterator first, iterator last)
+			{
+				_tree.remove(first, last);
+			}
+
+			// --- Split / join --- //
+			// Nodes are moved between the maps in O(log n), without copying
+			// nor reallocating. Both maps must use equal comparators and
+			// allocators.
+
+			// Moves every element whose key is not less than key to right,
+			// whose previous content is cleared.
+			void	split(const key_type& key, map& right)
+			{
+				_tree.split(key, right._tree);
+			}
+
+			// Moves every element of right after the elements of this map,
+			// in O(log n) when all keys of right are greater than the keys
+			// of this map. right is left empty.
+			void	join(map& right)
+			{
+				_tree.join(right._tree);
+			}
+
+			// --- Partitioning --- //
+			// Cuts [first, last) into parts sub-ranges holding the same
+			// number of elements (give or take one), in O(parts * log n).
+			// Sub-ranges may then be walked concurrently, see parallel.hpp.
+			ft::vector<ft::pair<iterator, iterator> >	partition(iterator first, iterator last, size_type parts)
+			{
+				ft::vector<ft::pair<iterator, iterator> >	ranges;
+				size_type									offset = _tree.rank(first);
+				size_type									count = _tree.rank(last) - offset;
+				iterator									bound = first;
+
+				if (parts == 0 || count == 0)
+					return ranges;
+				if (parts > count)
+					parts = count;
+
+				ranges.reserve(parts);
+				for (size_type i = 1; i <= parts; ++i)
+				{
+					iterator	next = (i == parts) ? last : _tree.select(offset + count * i / parts);
+
+					ranges.push_back(ft::make_pair(bound, next));
+					bound = next;
+				}
+				return ranges;
+			}
+
+			ft::vector<ft::pair<iterator, iterator> >	partition(size_type parts)
+			{
+				return partition(begin(), end(), parts);
+			}
+
+			// --- Freezing --- //
+			// Read-only copy of the map laid out for fast lookups, for the
+			// phases where it no longer changes. The map is left as is.
+			ft::frozen_map<Key, T, Compare, Allocator>	freeze() const
+			{
+				return ft::frozen_map<Key, T, Compare, Allocator>(begin(), end(), _comp, _alloc);
+			}
+
+	};
+
+	// Same as ft::map, but equivalent keys may be inserted several times.
+	// They are kept in insertion order. There is no operator[] nor at().
+	template <
+		class Key,
+		class T,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<ft::pair<const Key, T> >
+	>
+	class multimap
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef ft::pair<const Key, T>						value_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef Compare										key_compare;
+			typedef Allocator									allocator_type;
+
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+
+			// --- Value compare --- //
+			struct value_compare
+			{
+				// Needed for accessing private members of multimap
+				friend class multimap;
+
+				protected:
+					Compare	_comp;
+
+				public:
+					typedef bool result_type;
+					typedef value_type first_argument_type;
+					typedef value_type second_argument_type;
+
+					value_compare(Compare c): _comp(c) {}
+					value_compare(const value_compare& x): _comp(x._comp) {}
+
+					bool operator()(const value_type& x, const value_type& y) const
+					{
+						return _comp(x.first, y.first);
+					}
+			};
+
+		private:
+			// Only the keys are compared
+			typedef ft::RBTree<value_type, key_compare, allocator_type, ft::select_first<value_type> >	tree_type;
+
+		public:
+			// --- Iterator types --- //
+			typedef typename tree_type::iterator				iterator;
+			typedef typename tree_type::const_iterator			const_iterator;
+			typedef typename tree_type::reverse_iterator		reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator	const_reverse_iterator;
+
+		private:
+			// -------------------------------------------------------------- //
+			//  Data members                                                  //
+			// -------------------------------------------------------------- //
+			tree_type		_tree;
+			allocator_type	_alloc;
+			key_compare		_comp;
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors                                                  //
+			// -------------------------------------------------------------- //
+			explicit multimap(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+				_tree(comp, alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{}
+
+			template <class InputIterator>
+			multimap(
+				InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()
+			):
+				_tree(comp, alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{
+				insert(first, last);
+			}
+
+			multimap(const multimap& x):
+				_tree(x._tree),
+				_alloc(_tree.get_allocator()),
+				_comp(x._comp)
+			{}
+
+			multimap& operator=(const multimap& x)
+			{
+				_tree = x._tree;
+				_alloc = _tree.get_allocator();
+				_comp = x._comp;
+				return *this;
+			}
+
+			// --- Destructor --- //
+			~multimap()
+			{}
+
+			allocator_type	get_allocator() const
+			{
+				return _alloc;
+			}
+
+			key_compare	key_comp() const
+			{
+				return _comp;
+			}
+
+			value_compare	value_comp() const
+			{
+				return value_compare(_comp);
+			}
+
+			// -------------------------------------------------------------- //
+			//  Iterators                                                     //
+			// -------------------------------------------------------------- //
+			iterator begin()
+			{
+				return _tree.begin();
+			}
+
+			const_iterator begin() const
+			{
+				return _tree.begin();
+			}
+
+			iterator end()
+			{
+				return _tree.end();
+			}
+
+			const_iterator end() const
+			{
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin()
+			{
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend()
+			{
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return _tree.rend();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Capacity --- //
+			bool empty() const
+			{
+				return _tree.getRoot() == nullptr;
+			}
+
+			size_type size() const
+			{
+				return _tree.size();
+			}
+
+			size_type max_size() const
+			{
+				return _alloc.max_size();
+			}
+
+			// --- Statistics --- //
+			ft::container_stats	stats() const
+			{
+				return _tree.stats();
+			}
+
+			void	reset_stats()
+			{
+				_tree.reset_stats();
+			}
+
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage = _tree.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				_tree.clear();
+			}
+
+			void	swap(multimap& other)
+			{
+				_tree.swap(other._tree);
+				std::swap(_alloc, other._alloc);
+				std::swap(_comp, other._comp);
+			}
+
+			iterator	insert(const value_type& val)
+			{
+				return _tree.insertMulti(val);
+			}
+
+			template <class InputIterator>
+			void	insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					_tree.insertMulti(*first);
+			}
+
+			void	erase(iterator pos)
+			{
+				_tree.remove(pos);
+			}
+
+			// Erases all the elements whose key is equivalent to key
+			size_type	erase(const key_type& key)
+			{
+				return _tree.remove(key);
+			}
+
+			// O(k + log n) for k erased elements, see RBTree::remove
+			void	erase(iterator first, iterator last)
+			{
+				_tree.remove(first, last);
+			}
+
+			// --- Lookup --- //
+			// O(log n) whatever the number of duplicates, using the subtree
+			// counts of the tree
+			size_type	count(const key_type& key) const
+			{
+				return _tree.rank(iterator(_tree.upperBound(key))) - _tree.rank(iterator(_tree.lowerBound(key)));
+			}
+
+			// First of the elements with an equivalent key
+			iterator	find(const key_type& key)
+			{
+				typename tree_type::node_pointer	node = _tree.search(key);
+
+				return node == nullptr ? end() : iterator(node);
+			}
+
+			const_iterator	find(const key_type& key) const
+			{
+				typename tree_type::node_pointer	node = _tree.search(key);
+
+				return node == nullptr ? end() : const_iterator(node);
+			}
+
+			iterator	lower_bound(const key_type& key)
+			{
+				return iterator(_tree.lowerBound(key));
+			}
+
+			const_iterator	lower_bound(const key_type& key) const
+			{
+				return const_iterator(_tree.lowerBound(key));
+			}
+
+			iterator	upper_bound(const key_type& key)
+			{
+				return iterator(_tree.upperBound(key));
+			}
+
+			const_iterator	upper_bound(const key_type& key) const
+			{
+				return const_iterator(_tree.upperBound(key));
+			}
+
+			ft::pair<iterator, iterator>	equal_range(const key_type& key)
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			// --- Split / join --- //
+			// See map::split and map::join. Elements of right equivalent to
+			// the last element of this multimap still join in O(log n).
+
+			void	split(const key_type& key, multimap& right)
+			{
+				_tree.split(key, right._tree);
+			}
+
+			void	join(multimap& right)
+			{
+				_tree.join(right._tree, true);
+			}
+
 	};
 
 }
@@ -0,0 +1,691 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <memory>
+
+#include "allocator_traits.hpp"
+
+namespace ft
+{
+
+	// Alignment of T, computed the C++98 way from the padding the compiler
+	// puts in front of it.
+	template <class T>
+	struct alignment_of
+	{
+		struct helper
+		{
+			char	c;
+			T		t;
+		};
+
+		static const std::size_t	value = sizeof(helper) - sizeof(T);
+	};
+
+namespace pmr
+{
+
+	union max_align_t
+	{
+		long double	ld;
+		long long	ll;
+		double		d;
+		void		*p;
+		void		(*f)(void);
+	};
+
+	const std::size_t	max_align = ft::alignment_of<max_align_t>::value;
+
+	inline std::size_t	align_up(std::size_t value, std::size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// -------------------------------------------------------------------------- //
+	//  Memory resource                                                           //
+	// -------------------------------------------------------------------------- //
+	// https://devdocs.io/cpp/memory/memory_resource
+	class memory_resource
+	{
+		public:
+			virtual ~memory_resource() {}
+
+			void	*allocate(std::size_t bytes, std::size_t alignment = max_align)
+			{
+				return do_allocate(bytes, alignment);
+			}
+
+			void	deallocate(void *p, std::size_t bytes, std::size_t alignment = max_align)
+			{
+				do_deallocate(p, bytes, alignment);
+			}
+
+			bool	is_equal(const memory_resource &other) const
+			{
+				return do_is_equal(other);
+			}
+
+		private:
+			virtual void	*do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+			virtual void	do_deallocate(void *p, std::size_t bytes, std::size_t alignment) = 0;
+			virtual bool	do_is_equal(const memory_resource &other) const = 0;
+	};
+
+	inline bool	operator==(const memory_resource &lhs, const memory_resource &rhs)
+	{
+		return &lhs == &rhs || lhs.is_equal(rhs);
+	}
+
+	inline bool	operator!=(const memory_resource &lhs, const memory_resource &rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	// --- Global heap --- //
+	class new_delete_resource_type: public memory_resource
+	{
+		private:
+			virtual void	*do_allocate(std::size_t bytes, std::size_t alignment)
+			{
+				void	*p = NULL;
+
+				if (alignment <= max_align)
+					return ::operator new(bytes);
+				if (posix_memalign(&p, alignment, bytes) != 0)
+					throw std::bad_alloc();
+				return p;
+			}
+
+			virtual void	do_deallocate(void *p, std::size_t, std::size_t alignment)
+			{
+				if (alignment <= max_align)
+					::operator delete(p);
+				else
+					std::free(p);
+			}
+
+			virtual bool	do_is_equal(const memory_resource &other) const
+			{
+				return this == &other;
+			}
+	};
+
+	// --- Always failing resource --- //
+	class null_resource_type: public memory_resource
+	{
+		private:
+			virtual void	*do_allocate(std::size_t, std::size_t)
+			{
+				throw std::bad_alloc();
+			}
+
+			virtual void	do_deallocate(void *, std::size_t, std::size_t) {}
+
+			virtual bool	do_is_equal(const memory_resource &other) const
+			{
+				return this == &other;
+			}
+	};
+
+	inline memory_resource	*new_delete_resource(void)
+	{
+		static new_delete_resource_type	resource;
+
+		return &resource;
+	}
+
+	inline memory_resource	*null_memory_resource(void)
+	{
+		static null_resource_type	resource;
+
+		return &resource;
+	}
+
+	inline memory_resource	*&default_resource_storage(void)
+	{
+		static memory_resource	*resource = new_delete_resource();
+
+		return resource;
+	}
+
+	inline memory_resource	*get_default_resource(void)
+	{
+		return default_resource_storage();
+	}
+
+	// Returns the previous default resource, NULL restores new_delete_resource()
+	inline memory_resource	*set_default_resource(memory_resource *resource)
+	{
+		if (resource == NULL)
+			resource = new_delete_resource();
+		return __sync_lock_test_and_set(&default_resource_storage(), resource);
+	}
+
+	// -------------------------------------------------------------------------- //
+	//  Monotonic buffer resource                                                 //
+	// -------------------------------------------------------------------------- //
+	// Hands out memory by bumping a pointer, deallocate() does nothing and
+	// everything is given back at once by release() or the destructor. Once
+	// the current buffer is exhausted a twice larger one is requested from
+	// upstream.
+	class monotonic_buffer_resource: public memory_resource
+	{
+		private:
+			struct chunk
+			{
+				chunk		*next;
+				std::size_t	bytes;
+			};
+
+			static const std::size_t	default_size = 1024;
+
+			memory_resource	*_upstream;
+			void			*_initialBuffer;
+			std::size_t		_initialSize;
+			char			*_current;
+			std::size_t		_space;
+			std::size_t		_nextSize;
+			chunk			*_chunks;
+
+			// Not copyable
+			monotonic_buffer_resource(const monotonic_buffer_resource &);
+			monotonic_buffer_resource	&operator=(const monotonic_buffer_resource &);
+
+			void	reset(void)
+			{
+				_current = static_cast<char *>(_initialBuffer);
+				_space = _initialSize;
+			}
+
+			void	newChunk(std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t	header = align_up(sizeof(chunk), max_align);
+				std::size_t	size = _nextSize;
+				chunk		*block;
+
+				if (size < header + bytes + alignment)
+					size = header + bytes + alignment;
+
+				block = static_cast<chunk *>(_upstream->allocate(size, max_align));
+				block->next = _chunks;
+				block->bytes = size;
+				_chunks = block;
+
+				_current = reinterpret_cast<char *>(block) + header;
+				_space = size - header;
+				_nextSize = size * 2;
+			}
+
+			virtual void	*do_allocate(std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t	padding;
+
+				if (bytes == 0)
+					bytes = 1;
+
+				padding = align_up(reinterpret_cast<std::size_t>(_current), alignment) - reinterpret_cast<std::size_t>(_current);
+				if (_current == NULL || padding + bytes > _space)
+				{
+					newChunk(bytes, alignment);
+					padding = align_up(reinterpret_cast<std::size_t>(_current), alignment) - reinterpret_cast<std::size_t>(_current);
+				}
+
+				void	*p = _current + padding;
+
+				_current += padding + bytes;
+				_space -= padding + bytes;
+				return p;
+			}
+
+			virtual void	do_deallocate(void *, std::size_t, std::size_t) {}
+
+			virtual bool	do_is_equal(const memory_resource &other) const
+			{
+				return this == &other;
+			}
+
+		public:
+			explicit monotonic_buffer_resource(memory_resource *upstream = get_default_resource()):
+				_upstream(upstream),
+				_initialBuffer(NULL),
+				_initialSize(0),
+				_current(NULL),
+				_space(0),
+				_nextSize(default_size),
+				_chunks(NULL)
+			{}
+
+			explicit monotonic_buffer_resource(std::size_t initialSize, memory_resource *upstream = get_default_resource()):
+				_upstream(upstream),
+				_initialBuffer(NULL),
+				_initialSize(0),
+				_current(NULL),
+				_space(0),
+				_nextSize(initialSize > 0 ? initialSize : 1),
+				_chunks(NULL)
+			{}
+
+			// The buffer is used first and is never freed by the resource
+			monotonic_buffer_resource(void *buffer, std::size_t size, memory_resource *upstream = get_default_resource()):
+				_upstream(upstream),
+				_initialBuffer(buffer),
+				_initialSize(size),
+				_current(static_cast<char *>(buffer)),
+				_space(size),
+				_nextSize(size > 0 ? size * 2 : default_size),
+				_chunks(NULL)
+			{}
+
+			virtual ~monotonic_buffer_resource()
+			{
+				release();
+			}
+
+			// Gives every chunk back to upstream and restarts from the
+			// initial buffer.
+			void	release(void)
+			{
+				while (_chunks != NULL)
+				{
+					chunk	*next = _chunks->next;
+
+					_upstream->deallocate(_chunks, _chunks->bytes, max_align);
+					_chunks = next;
+				}
+				reset();
+			}
+
+			memory_resource	*upstream_resource(void) const
+			{
+				return _upstream;
+			}
+	};
+
+	// -------------------------------------------------------------------------- //
+	//  Unsynchronized pool resource                                              //
+	// -------------------------------------------------------------------------- //
+	struct pool_options
+	{
+		std::size_t	max_blocks_per_chunk;
+		std::size_t	largest_required_pool_block;
+
+		pool_options():
+			max_blocks_per_chunk(0),
+			largest_required_pool_block(0)
+		{}
+	};
+
+	// Keeps one free list per power of two block size. Blocks are carved
+	// from chunks requested to upstream, chunks growing geometrically up to
+	// max_blocks_per_chunk blocks. Larger requests go straight to upstream.
+	// Not thread safe.
+	class unsynchronized_pool_resource: public memory_resource
+	{
+		private:
+			struct chunk
+			{
+				chunk		*next;
+				std::size_t	bytes;
+			};
+
+			struct free_block
+			{
+				free_block	*next;
+			};
+
+			struct pool
+			{
+				std::size_t	blockSize;
+				std::size_t	nextBlocks;
+				free_block	*freeList;
+				chunk		*chunks;
+			};
+
+			// Kept right after every oversized block so that it can be
+			// unlinked in O(1) when given back.
+			struct large_block
+			{
+				large_block	*prev;
+				large_block	*next;
+				void		*p;
+				std::size_t	bytes;
+				std::size_t	alignment;
+			};
+
+			static const std::size_t	min_block = sizeof(void *);
+			static const std::size_t	max_pools = 24;
+
+			memory_resource	*_upstream;
+			pool_options	_options;
+			pool			_pools[max_pools];
+			std::size_t		_poolCount;
+			large_block		*_large;
+
+			// Not copyable
+			unsynchronized_pool_resource(const unsynchronized_pool_resource &);
+			unsynchronized_pool_resource	&operator=(const unsynchronized_pool_resource &);
+
+			void	init(const pool_options &options)
+			{
+				std::size_t	size = min_block;
+
+				_options = options;
+				if (_options.max_blocks_per_chunk == 0)
+					_options.max_blocks_per_chunk = 1024;
+				if (_options.largest_required_pool_block == 0)
+					_options.largest_required_pool_block = 4096;
+
+				_poolCount = 0;
+				while (_poolCount < max_pools && size <= _options.largest_required_pool_block)
+				{
+					_pools[_poolCount].blockSize = size;
+					_pools[_poolCount].nextBlocks = 4;
+					_pools[_poolCount].freeList = NULL;
+					_pools[_poolCount].chunks = NULL;
+					++_poolCount;
+					size *= 2;
+				}
+				_options.largest_required_pool_block = size / 2;
+			}
+
+			// Index of the smallest pool fitting, _poolCount if none
+			std::size_t	poolIndex(std::size_t bytes, std::size_t alignment) const
+			{
+				std::size_t	index = 0;
+
+				if (alignment > max_align)
+					return _poolCount;
+				if (bytes < alignment)
+					bytes = alignment;
+				while (index < _poolCount && _pools[index].blockSize < bytes)
+					++index;
+				return index;
+			}
+
+			void	refill(pool &p)
+			{
+				std::size_t	header = align_up(sizeof(chunk), max_align);
+				std::size_t	bytes = header + p.nextBlocks * p.blockSize;
+				chunk		*block = static_cast<chunk *>(_upstream->allocate(bytes, max_align));
+				char		*first = reinterpret_cast<char *>(block) + header;
+
+				block->next = p.chunks;
+				block->bytes = bytes;
+				p.chunks = block;
+
+				for (std::size_t i = p.nextBlocks; i > 0; --i)
+				{
+					free_block	*b = reinterpret_cast<free_block *>(first + (i - 1) * p.blockSize);
+
+					b->next = p.freeList;
+					p.freeList = b;
+				}
+
+				p.nextBlocks *= 2;
+				if (p.nextBlocks > _options.max_blocks_per_chunk)
+					p.nextBlocks = _options.max_blocks_per_chunk;
+			}
+
+			virtual void	*do_allocate(std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t	index = poolIndex(bytes, alignment);
+
+				if (index < _poolCount)
+				{
+					pool		&p = _pools[index];
+					free_block	*block;
+
+					if (p.freeList == NULL)
+						refill(p);
+					block = p.freeList;
+					p.freeList = block->next;
+					return block;
+				}
+
+				std::size_t	offset = align_up(bytes, ft::alignment_of<large_block>::value);
+				std::size_t	align = alignment > max_align ? alignment : max_align;
+				void		*p = _upstream->allocate(offset + sizeof(large_block), align);
+				large_block	*block = reinterpret_cast<large_block *>(static_cast<char *>(p) + offset);
+
+				block->prev = NULL;
+				block->next = _large;
+				block->p = p;
+				block->bytes = offset + sizeof(large_block);
+				block->alignment = align;
+				if (_large != NULL)
+					_large->prev = block;
+				_large = block;
+				return p;
+			}
+
+			virtual void	do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t	index = poolIndex(bytes, alignment);
+
+				if (p == NULL)
+					return ;
+
+				if (index < _poolCount)
+				{
+					free_block	*block = static_cast<free_block *>(p);
+
+					block->next = _pools[index].freeList;
+					_pools[index].freeList = block;
+					return ;
+				}
+
+				large_block	*block = reinterpret_cast<large_block *>(static_cast<char *>(p)
+					+ align_up(bytes, ft::alignment_of<large_block>::value));
+
+				if (block->prev != NULL)
+					block->prev->next = block->next;
+				else
+					_large = block->next;
+				if (block->next != NULL)
+					block->next->prev = block->prev;
+				_upstream->deallocate(block->p, block->bytes, block->alignment);
+			}
+
+			virtual bool	do_is_equal(const memory_resource &other) const
+			{
+				return this == &other;
+			}
+
+		public:
+			unsynchronized_pool_resource():
+				_upstream(get_default_resource()),
+				_large(NULL)
+			{
+				init(pool_options());
+			}
+
+			explicit unsynchronized_pool_resource(memory_resource *upstream):
+				_upstream(upstream),
+				_large(NULL)
+			{
+				init(pool_options());
+			}
+
+			explicit unsynchronized_pool_resource(const pool_options &options, memory_resource *upstream = get_default_resource()):
+				_upstream(upstream),
+				_large(NULL)
+			{
+				init(options);
+			}
+
+			virtual ~unsynchronized_pool_resource()
+			{
+				release();
+			}
+
+			// Gives all the memory back to upstream, even blocks still in use
+			void	release(void)
+			{
+				for (std::size_t i = 0; i < _poolCount; ++i)
+				{
+					while (_pools[i].chunks != NULL)
+					{
+						chunk	*next = _pools[i].chunks->next;
+
+						_upstream->deallocate(_pools[i].chunks, _pools[i].chunks->bytes, max_align);
+						_pools[i].chunks = next;
+					}
+					_pools[i].freeList = NULL;
+					_pools[i].nextBlocks = 4;
+				}
+				while (_large != NULL)
+				{
+					large_block	*next = _large->next;
+
+					_upstream->deallocate(_large->p, _large->bytes, _large->alignment);
+					_large = next;
+				}
+			}
+
+			memory_resource	*upstream_resource(void) const
+			{
+				return _upstream;
+			}
+
+			pool_options	options(void) const
+			{
+				return _options;
+			}
+	};
+
+	// -------------------------------------------------------------------------- //
+	//  Polymorphic allocator                                                     //
+	// -------------------------------------------------------------------------- //
+	// A C++98 allocator forwarding to a memory_resource, e.g.:
+	//   ft::pmr::monotonic_buffer_resource                          arena;
+	//   ft::vector<int, ft::pmr::polymorphic_allocator<int> >       v(&arena);
+	// ft::map also allocates its nodes from the resource it is given.
+	template <class T>
+	class polymorphic_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef polymorphic_allocator<U>	other;
+			};
+
+		private:
+			memory_resource	*_resource;
+
+		public:
+			polymorphic_allocator():
+				_resource(get_default_resource())
+			{}
+
+			polymorphic_allocator(memory_resource *resource):
+				_resource(resource)
+			{}
+
+			polymorphic_allocator(const polymorphic_allocator &other):
+				_resource(other._resource)
+			{}
+
+			template <class U>
+			polymorphic_allocator(const polymorphic_allocator<U> &other):
+				_resource(other.resource())
+			{}
+
+			polymorphic_allocator	&operator=(const polymorphic_allocator &other)
+			{
+				_resource = other._resource;
+				return *this;
+			}
+
+			pointer	allocate(size_type n, const void * = 0)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(_resource->allocate(n * sizeof(T), ft::alignment_of<T>::value));
+			}
+
+			void	deallocate(pointer p, size_type n)
+			{
+				if (p != NULL)
+					_resource->deallocate(p, n * sizeof(T), ft::alignment_of<T>::value);
+			}
+
+			void	construct(pointer p, const_reference value)
+			{
+				new (static_cast<void *>(p)) T(value);
+			}
+
+			void	destroy(pointer p)
+			{
+				p->~T();
+			}
+
+			size_type	max_size(void) const
+			{
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			pointer	address(reference x) const
+			{
+				return &x;
+			}
+
+			const_pointer	address(const_reference x) const
+			{
+				return &x;
+			}
+
+			// Copies of a container do not inherit the resource
+			polymorphic_allocator	select_on_container_copy_construction(void) const
+			{
+				return polymorphic_allocator();
+			}
+
+			memory_resource	*resource(void) const
+			{
+				return _resource;
+			}
+	};
+
+	template <class T, class U>
+	bool	operator==(const polymorphic_allocator<T> &lhs, const polymorphic_allocator<U> &rhs)
+	{
+		return *lhs.resource() == *rhs.resource();
+	}
+
+	template <class T, class U>
+	bool	operator!=(const polymorphic_allocator<T> &lhs, const polymorphic_allocator<U> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+}
+
+	// The resource never follows the elements, a container keeps the one
+	// it was built with for its whole lifetime.
+	template <class T>
+	struct allocator_traits<pmr::polymorphic_allocator<T> >
+	{
+		typedef pmr::polymorphic_allocator<T>	allocator_type;
+
+		static const bool	propagate_on_container_copy_assignment = false;
+		static const bool	propagate_on_container_move_assignment = false;
+		static const bool	propagate_on_container_swap = false;
+
+		static allocator_type	select_on_container_copy_construction(const allocator_type &alloc)
+		{
+			return alloc.select_on_container_copy_construction();
+		}
+	};
+
+}
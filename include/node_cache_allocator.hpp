@@ -0,0 +1,437 @@
+#pragma once
+
+#include <pthread.h>
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <algorithm>
+
+namespace ft
+{
+
+	// -------------------------------------------------------------------------- //
+	//  Node caches                                                               //
+	// -------------------------------------------------------------------------- //
+	// Per-thread caches of free blocks for single node allocations, in the
+	// magazine layout of Bonwick's slab allocator. Blocks are sorted in size
+	// classes of node_cache_granularity bytes. Every thread keeps two
+	// magazines, arrays of up to node_magazine_size free blocks, per class:
+	// allocating pops from them and freeing pushes to them without any lock.
+	// Only when both are empty, or both full, does the thread exchange a
+	// whole magazine with the depot shared by all threads, under the lock of
+	// that class. The global heap is only reached when the depot has no full
+	// magazine to give, or too many to take one more.
+	//
+	// Every block of a class comes from ::operator new and is interchangeable
+	// with the others, so a block freed by another thread than the one that
+	// allocated it simply goes to the cache of the freeing thread. A thread
+	// gives its magazines to the depot when it exits.
+
+	const std::size_t	node_cache_granularity = 16;
+	const std::size_t	node_cache_classes = 32;		// Blocks up to 512 bytes
+	const std::size_t	node_magazine_size = 64;
+	const std::size_t	node_depot_magazines = 256;		// Kept per class and list
+
+	struct node_magazine
+	{
+		std::size_t		count;
+		node_magazine	*next;		// In the depot lists
+		void			*blocks[node_magazine_size];
+
+		node_magazine():
+			count(0),
+			next(NULL)
+		{}
+
+		bool	empty(void) const
+		{
+			return count == 0;
+		}
+
+		bool	full(void) const
+		{
+			return count == node_magazine_size;
+		}
+	};
+
+	inline void	delete_magazine(node_magazine *magazine)
+	{
+		if (magazine == NULL)
+			return ;
+		while (magazine->count != 0)
+			::operator delete(magazine->blocks[--magazine->count]);
+		delete magazine;
+	}
+
+	// --- Depot --- //
+	// Magazines given back by the threads, a list of loaded ones and a list
+	// of empty ones per class
+	class node_cache_depot
+	{
+		private:
+			struct list
+			{
+				node_magazine	*head;
+				std::size_t		size;
+			};
+
+			struct depot_class
+			{
+				pthread_mutex_t	mutex;
+				list			loaded;
+				list			empty;
+			};
+
+			depot_class	_classes[node_cache_classes];
+
+			static node_magazine	*pop(list &from)
+			{
+				node_magazine	*magazine = from.head;
+
+				if (magazine != NULL)
+				{
+					from.head = magazine->next;
+					--from.size;
+				}
+				return magazine;
+			}
+
+			// Returns magazine when the list is full
+			static node_magazine	*push(list &to, node_magazine *magazine)
+			{
+				if (to.size == node_depot_magazines)
+					return magazine;
+				magazine->next = to.head;
+				to.head = magazine;
+				++to.size;
+				return NULL;
+			}
+
+			node_cache_depot(const node_cache_depot &);
+			node_cache_depot	&operator=(const node_cache_depot &);
+
+		public:
+			node_cache_depot()
+			{
+				for (std::size_t i = 0; i < node_cache_classes; ++i)
+				{
+					pthread_mutex_init(&_classes[i].mutex, NULL);
+					_classes[i].loaded.head = NULL;
+					_classes[i].loaded.size = 0;
+					_classes[i].empty.head = NULL;
+					_classes[i].empty.size = 0;
+				}
+			}
+
+			// Never destroyed, threads may exit after static destructors ran
+			static node_cache_depot	&instance(void)
+			{
+				static node_cache_depot	*depot = new node_cache_depot();
+
+				return *depot;
+			}
+
+			// A magazine holding blocks in exchange for an empty one, NULL if
+			// there is none and empty is kept by the caller
+			node_magazine	*exchangeEmpty(std::size_t sizeClass, node_magazine *empty)
+			{
+				depot_class		&c = _classes[sizeClass];
+				node_magazine	*loaded;
+
+				pthread_mutex_lock(&c.mutex);
+				loaded = pop(c.loaded);
+				if (loaded != NULL && empty != NULL)
+					empty = push(c.empty, empty);
+				pthread_mutex_unlock(&c.mutex);
+				if (loaded != NULL)
+					delete_magazine(empty);
+				return loaded;
+			}
+
+			// An empty magazine in exchange for a loaded one, the blocks of
+			// which go back to the heap if the depot already has enough
+			node_magazine	*exchangeLoaded(std::size_t sizeClass, node_magazine *loaded)
+			{
+				depot_class		&c = _classes[sizeClass];
+				node_magazine	*empty;
+
+				pthread_mutex_lock(&c.mutex);
+				empty = pop(c.empty);
+				loaded = push(c.loaded, loaded);
+				pthread_mutex_unlock(&c.mutex);
+				if (loaded != NULL)
+				{
+					delete_magazine(empty);
+					while (loaded->count != 0)
+						::operator delete(loaded->blocks[--loaded->count]);
+					return loaded;
+				}
+				return empty != NULL ? empty : new node_magazine();
+			}
+
+			// Takes a magazine from an exiting thread
+			void	give(std::size_t sizeClass, node_magazine *magazine)
+			{
+				depot_class	&c = _classes[sizeClass];
+
+				if (magazine == NULL)
+					return ;
+				pthread_mutex_lock(&c.mutex);
+				magazine = push(magazine->empty() ? c.empty : c.loaded, magazine);
+				pthread_mutex_unlock(&c.mutex);
+				delete_magazine(magazine);
+			}
+
+			// Returns every block and magazine held by the depot to the heap
+			void	trim(void)
+			{
+				for (std::size_t i = 0; i < node_cache_classes; ++i)
+				{
+					list	loaded;
+					list	empty;
+
+					pthread_mutex_lock(&_classes[i].mutex);
+					loaded = _classes[i].loaded;
+					empty = _classes[i].empty;
+					_classes[i].loaded.head = _classes[i].empty.head = NULL;
+					_classes[i].loaded.size = _classes[i].empty.size = 0;
+					pthread_mutex_unlock(&_classes[i].mutex);
+					while (loaded.head != NULL)
+						delete_magazine(pop(loaded));
+					while (empty.head != NULL)
+						delete_magazine(pop(empty));
+				}
+			}
+	};
+
+	// --- Thread caches --- //
+	class node_thread_cache
+	{
+		private:
+			struct cache_class
+			{
+				node_magazine	*loaded;	// Used first
+				node_magazine	*previous;	// Swapped with loaded when it runs out
+			};
+
+			cache_class	_classes[node_cache_classes];
+
+			node_thread_cache(const node_thread_cache &);
+			node_thread_cache	&operator=(const node_thread_cache &);
+
+			static pthread_key_t	&key(void)
+			{
+				static pthread_key_t	key;
+
+				return key;
+			}
+
+			static void	createKey(void)
+			{
+				pthread_key_create(&key(), &release);
+			}
+
+			// Called at thread exit
+			static void	release(void *cache)
+			{
+				delete static_cast<node_thread_cache *>(cache);
+			}
+
+			static node_thread_cache	*&current(void)
+			{
+				static __thread node_thread_cache	*cache = NULL;
+
+				return cache;
+			}
+
+		public:
+			node_thread_cache()
+			{
+				for (std::size_t i = 0; i < node_cache_classes; ++i)
+				{
+					_classes[i].loaded = NULL;
+					_classes[i].previous = NULL;
+				}
+			}
+
+			~node_thread_cache()
+			{
+				node_cache_depot	&depot = node_cache_depot::instance();
+
+				for (std::size_t i = 0; i < node_cache_classes; ++i)
+				{
+					depot.give(i, _classes[i].loaded);
+					depot.give(i, _classes[i].previous);
+				}
+				if (current() == this)
+					current() = NULL;
+			}
+
+			// Cache of the calling thread, created on first use
+			static node_thread_cache	&instance(void)
+			{
+				static pthread_once_t	once = PTHREAD_ONCE_INIT;
+				node_thread_cache		*&cache = current();
+
+				if (cache == NULL)
+				{
+					pthread_once(&once, &createKey);
+					cache = new node_thread_cache();
+					pthread_setspecific(key(), cache);
+				}
+				return *cache;
+			}
+
+			void	*allocate(std::size_t sizeClass)
+			{
+				cache_class	&c = _classes[sizeClass];
+
+				if (c.loaded == NULL || c.loaded->empty())
+				{
+					if (c.previous != NULL && !c.previous->empty())
+						std::swap(c.loaded, c.previous);
+					else
+					{
+						node_magazine	*loaded = node_cache_depot::instance().exchangeEmpty(sizeClass, c.previous);
+
+						if (loaded == NULL)
+							return ::operator new((sizeClass + 1) * node_cache_granularity);
+						c.previous = c.loaded;
+						c.loaded = loaded;
+					}
+				}
+				return c.loaded->blocks[--c.loaded->count];
+			}
+
+			void	deallocate(void *block, std::size_t sizeClass)
+			{
+				cache_class	&c = _classes[sizeClass];
+
+				if (c.loaded == NULL || c.loaded->full())
+				{
+					if (c.previous == NULL || c.previous->empty())
+					{
+						std::swap(c.loaded, c.previous);
+						if (c.loaded == NULL)
+							c.loaded = new node_magazine();
+					}
+					else
+					{
+						node_magazine	*empty = node_cache_depot::instance().exchangeLoaded(sizeClass, c.previous);
+
+						c.previous = c.loaded;
+						c.loaded = empty;
+					}
+				}
+				c.loaded->blocks[c.loaded->count++] = block;
+			}
+	};
+
+	// Hands the blocks cached by the depot back to the heap, those in the
+	// threads' own magazines stay there
+	inline void	node_cache_trim(void)
+	{
+		node_cache_depot::instance().trim();
+	}
+
+	// -------------------------------------------------------------------------- //
+	//  Node cache allocator                                                      //
+	// -------------------------------------------------------------------------- //
+	// Stateless allocator serving single objects of up to 512 bytes, like the
+	// nodes of ft::map, ft::set or ft::trie_map, from the node caches above.
+	// Arrays and larger objects go to ::operator new. All instances are equal:
+	// memory may be freed by any of them, from any thread.
+	//
+	//     ft::map<int, int, std::less<int>,
+	//         ft::node_cache_allocator<ft::pair<const int, int> > >
+	template <class T>
+	class node_cache_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef node_cache_allocator<U>	other;
+			};
+
+		private:
+			static const std::size_t	size_class = (sizeof(T) + node_cache_granularity - 1) / node_cache_granularity - 1;
+			static const bool			cached = size_class < node_cache_classes;
+
+		public:
+			node_cache_allocator()
+			{}
+
+			node_cache_allocator(const node_cache_allocator &)
+			{}
+
+			template <class U>
+			node_cache_allocator(const node_cache_allocator<U> &)
+			{}
+
+			pointer	allocate(size_type n, const void * = 0)
+			{
+				if (n == 1 && cached)
+					return static_cast<pointer>(node_thread_cache::instance().allocate(size_class));
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			}
+
+			void	deallocate(pointer p, size_type n)
+			{
+				if (p == NULL)
+					return ;
+				if (n == 1 && cached)
+					node_thread_cache::instance().deallocate(p, size_class);
+				else
+					::operator delete(p);
+			}
+
+			void	construct(pointer p, const_reference value)
+			{
+				::new (static_cast<void *>(p)) T(value);
+			}
+
+			void	destroy(pointer p)
+			{
+				p->~T();
+			}
+
+			size_type	max_size(void) const
+			{
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			pointer	address(reference x) const
+			{
+				return &x;
+			}
+
+			const_pointer	address(const_reference x) const
+			{
+				return &x;
+			}
+	};
+
+	template <class T, class U>
+	bool	operator==(const node_cache_allocator<T> &, const node_cache_allocator<U> &)
+	{
+		return true;
+	}
+
+	template <class T, class U>
+	bool	operator!=(const node_cache_allocator<T> &, const node_cache_allocator<U> &)
+	{
+		return false;
+	}
+
+}
@@ -19,6 +19,8 @@ namespace ft
 		pair(): first(), second() {}
 
 		// --- Copy constructor --- //
+		pair(const pair& pr): first(pr.first), second(pr.second) {}
+
 		pair(const first_type& x, const second_type& y): first(x), second(y) {}
 
 		template <class U, class V>
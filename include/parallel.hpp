@@ -0,0 +1,146 @@
+#pragma once
+
+#include <pthread.h>
+#include <unistd.h>
+#include <cstddef>
+#include <stdexcept>
+
+#include "vector.hpp"
+#include "utility.hpp"
+
+namespace ft
+{
+
+	// -------------------------------------------------------------------------- //
+	//  Parallel for_each                                                         //
+	// -------------------------------------------------------------------------- //
+	// Sub-ranges are handed out to a pool of POSIX threads, each worker taking
+	// the next unclaimed sub-range until none is left. The container must not
+	// be modified while the workers run.
+
+	// Number of ranges cut per worker, so that a slow range does not leave the
+	// other workers idle.
+	const std::size_t	parallel_ranges_per_thread = 4;
+
+	inline std::size_t	parallel_default_threads(void)
+	{
+		long	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+		return (cpus > 0 ? cpus : 1);
+	}
+
+	// Whether Container has partition(parts) giving its ranges, like ft::map
+	template <class Container>
+	struct has_partition
+	{
+		typedef char					yes;
+		typedef struct { char c[2]; }	no;
+
+		template <class U, ft::vector<ft::pair<typename U::iterator, typename U::iterator> > (U::*)(typename U::size_type)>
+		struct signature
+		{};
+
+		template <class U>
+		static yes	test(signature<U, &U::partition> *);
+
+		template <class U>
+		static no	test(...);
+
+		static const bool	value = sizeof(test<Container>(0)) == sizeof(yes);
+	};
+
+	template <class Iterator, class Function>
+	struct parallel_task
+	{
+		const ft::vector<ft::pair<Iterator, Iterator> >	*ranges;
+		std::size_t										*nextRange;
+		Function										function;
+		bool											failed;
+
+		parallel_task(const ft::vector<ft::pair<Iterator, Iterator> > *ranges, std::size_t *nextRange, Function function):
+			ranges(ranges),
+			nextRange(nextRange),
+			function(function),
+			failed(false)
+		{}
+	};
+
+	template <class Iterator, class Function>
+	void	*parallel_worker(void *arg)
+	{
+		parallel_task<Iterator, Function>	*task = static_cast<parallel_task<Iterator, Function> *>(arg);
+		std::size_t							index;
+
+		try
+		{
+			while ((index = __sync_fetch_and_add(task->nextRange, 1)) < task->ranges->size())
+			{
+				Iterator	first = (*task->ranges)[index].first;
+				Iterator	last = (*task->ranges)[index].second;
+
+				for (; first != last; ++first)
+					task->function(*first);
+			}
+		}
+		catch (...)
+		{
+			task->failed = true;
+		}
+		return NULL;
+	}
+
+	// Applies a copy of f to every element of the given ranges, one copy per
+	// worker thread. The copies are returned so that per-worker results can
+	// be reduced by the caller.
+	template <class Iterator, class Function>
+	ft::vector<Function>	parallel_for_each(const ft::vector<ft::pair<Iterator, Iterator> > &ranges, Function f,
+		std::size_t threads = parallel_default_threads())
+	{
+		typedef parallel_task<Iterator, Function>	task_type;
+
+		std::size_t				nextRange = 0;
+		ft::vector<task_type>	tasks;
+		ft::vector<pthread_t>	workers(threads == 0 ? 1 : threads);
+		ft::vector<bool>		started(workers.size(), false);
+		ft::vector<Function>	functions;
+		bool					failed = false;
+
+		// Tasks are never reallocated once the workers hold their address
+		tasks.reserve(workers.size());
+		for (std::size_t i = 0; i < workers.size(); ++i)
+			tasks.push_back(task_type(&ranges, &nextRange, f));
+
+		// The calling thread is the first worker
+		for (std::size_t i = 1; i < workers.size(); ++i)
+			started[i] = (pthread_create(&workers[i], NULL, &parallel_worker<Iterator, Function>, &tasks[i]) == 0);
+		parallel_worker<Iterator, Function>(&tasks[0]);
+
+		for (std::size_t i = 1; i < workers.size(); ++i)
+			if (started[i])
+				pthread_join(workers[i], NULL);
+
+		functions.reserve(tasks.size());
+		for (std::size_t i = 0; i < tasks.size(); ++i)
+		{
+			failed = failed || tasks[i].failed;
+			functions.push_back(tasks[i].function);
+		}
+		if (failed)
+			throw std::runtime_error("parallel_for_each: a worker threw");
+		return functions;
+	}
+
+	// Walks the whole container, which must provide partition(parts) like
+	// ft::map does. Other arguments, such as non-const range vectors, go to
+	// the overload above.
+	template <class Container, class Function>
+	typename ft::enable_if<has_partition<Container>::value, ft::vector<Function> >::type
+		parallel_for_each(Container &container, Function f,
+		std::size_t threads = parallel_default_threads())
+	{
+		if (threads == 0)
+			threads = 1;
+		return parallel_for_each(container.partition(threads * parallel_ranges_per_thread), f, threads);
+	}
+
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <functional>
+#include <algorithm>
+
+#include "vector.hpp"
+
+namespace ft
+{
+
+	// Implicit d-ary max-heap: the children of node i are the Arity slots
+	// starting at Arity * i + 1. Sift-down scans all the children of a node,
+	// which sit next to each other in memory, so a 4 or 8-ary heap touches
+	// about half or a third as many cache lines per level as a binary heap,
+	// on a tree that is also half or a third as deep.
+	//
+	// The Container must provide operator[], size(), empty(), back(),
+	// push_back() and pop_back(), like ft::vector and ft::deque do.
+	template< class T, class Container = ft::vector<T>,
+		class Compare = std::less<typename Container::value_type>, std::size_t Arity = 4 >
+	class priority_queue
+	{
+		private:
+			// Fails to compile for an arity lower than 2
+			typedef char	arity_must_be_at_least_2[Arity >= 2 ? 1 : -1];
+
+		protected:
+			Container	c;
+			Compare		comp;
+
+		public:
+			typedef Container							container_type;
+			typedef Compare								value_compare;
+			typedef typename Container::value_type		value_type;
+			typedef typename Container::reference		reference;
+			typedef typename Container::const_reference	const_reference;
+			typedef typename Container::size_type		size_type;
+
+			static const std::size_t	arity = Arity;
+
+		private:
+			// Both sifts take value by copy since it may be a slot of c
+
+			// Moves the hole up until value fits in it
+			void	siftUp(size_type hole, value_type value)
+			{
+				while (hole > 0)
+				{
+					size_type	parent = (hole - 1) / Arity;
+
+					if (!comp(c[parent], value))
+						break ;
+					c[hole] = c[parent];
+					hole = parent;
+				}
+				c[hole] = value;
+			}
+
+			// Moves the hole down to a leaf, pulling up the largest child each
+			// time, then moves it back up until value fits. A value coming
+			// from the bottom of the heap usually ends up near the bottom
+			// again, so this saves comparing it at every level on the way
+			// down.
+			void	siftDown(size_type hole, value_type value)
+			{
+				size_type	size = c.size();
+				size_type	top = hole;
+
+				for (;;)
+				{
+					size_type	first = hole * Arity + 1;
+					size_type	best = first;
+
+					if (first >= size)
+						break ;
+					if (first + Arity <= size)
+					{
+						// Full node, the fixed count lets the scan be unrolled
+						for (size_type i = 1; i < Arity; ++i)
+							if (comp(c[best], c[first + i]))
+								best = first + i;
+					}
+					else
+					{
+						for (size_type i = first + 1; i < size; ++i)
+							if (comp(c[best], c[i]))
+								best = i;
+					}
+					c[hole] = c[best];
+					hole = best;
+				}
+				while (hole > top)
+				{
+					size_type	parent = (hole - 1) / Arity;
+
+					if (!comp(c[parent], value))
+						break ;
+					c[hole] = c[parent];
+					hole = parent;
+				}
+				c[hole] = value;
+			}
+
+			// Floyd's bottom-up construction, O(n)
+			void	heapify(void)
+			{
+				size_type	size = c.size();
+
+				if (size < 2)
+					return ;
+				for (size_type i = (size - 2) / Arity + 1; i > 0; --i)
+					siftDown(i - 1, c[i - 1]);
+			}
+
+		public:
+			explicit priority_queue(const Compare& compare = Compare(), const Container& cont = Container()):
+				c(cont),
+				comp(compare)
+			{
+				heapify();
+			}
+
+			template <class InputIt>
+			priority_queue(InputIt first, InputIt last, const Compare& compare = Compare(), const Container& cont = Container()):
+				c(cont),
+				comp(compare)
+			{
+				for (; first != last; ++first)
+					c.push_back(*first);
+				heapify();
+			}
+
+			priority_queue(const priority_queue& other):	// Copy constructor
+				c(other.c),
+				comp(other.comp)
+			{}
+
+			priority_queue&	operator=(const priority_queue& other)	// Copy assignment operator
+			{
+				c = other.c;
+				comp = other.comp;
+				return *this;
+			}
+
+			bool			empty(void) const
+			{ return c.empty(); }
+
+			size_type		size(void) const
+			{ return c.size(); }
+
+			const_reference	top(void) const
+			{ return c[0]; }
+
+			void			push(const value_type& value)
+			{
+				c.push_back(value);
+				siftUp(c.size() - 1, c.back());
+			}
+
+			// Appends the whole range then restores the heap, either by
+			// rebuilding it in O(n) when the range is at least as large as
+			// the heap, or by sifting up the new elements otherwise.
+			template <class InputIt>
+			void			push_range(InputIt first, InputIt last)
+			{
+				size_type	oldSize = c.size();
+
+				for (; first != last; ++first)
+					c.push_back(*first);
+				if (c.size() - oldSize >= oldSize)
+					heapify();
+				else
+				{
+					for (size_type i = oldSize; i < c.size(); ++i)
+						siftUp(i, c[i]);
+				}
+			}
+
+			void			pop(void)
+			{
+				if (c.empty())
+					return ;
+
+				value_type	last = c.back();
+
+				c.pop_back();
+				if (!c.empty())
+					siftDown(0, last);
+			}
+
+			// Replaces the top with value in a single sift-down, instead of
+			// a pop() followed by a push()
+			void			pop_push(const value_type& value)
+			{
+				if (c.empty())
+					push(value);
+				else
+					siftDown(0, value);
+			}
+
+			ft::container_stats	stats(void) const	// Statistics of the underlying container
+			{ return c.stats(); }
+
+			ft::memory_usage	memory_usage(void) const	// Footprint of the underlying container
+			{
+				ft::memory_usage	usage = c.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
+	};
+
+	template< class T, class Container, class Compare, std::size_t Arity >
+	const std::size_t	priority_queue<T, Container, Compare, Arity>::arity;
+
+}
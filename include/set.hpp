@@ -0,0 +1,594 @@
+#pragma once
+
+#include <functional>
+
+#include "RBTree.hpp"
+#include "utility.hpp"
+
+namespace ft
+{
+
+	// The element is its own key: nodes hold nothing but the key and the
+	// tree compares keys directly, without a pair nor a mapped value.
+	// Elements cannot be modified in place, iterator is a const_iterator.
+	template <
+		class Key,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<Key>
+	>
+	class set
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef Key											key_type;
+			typedef Key											value_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef Compare										key_compare;
+			typedef Compare										value_compare;
+			typedef Allocator									allocator_type;
+
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+
+		private:
+			typedef ft::RBTree<value_type, key_compare, allocator_type>	tree_type;
+
+		public:
+			// --- Iterator types --- //
+			typedef typename tree_type::const_iterator			iterator;
+			typedef typename tree_type::const_iterator			const_iterator;
+			typedef typename tree_type::const_reverse_iterator	reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator	const_reverse_iterator;
+
+		private:
+			// -------------------------------------------------------------- //
+			//  Data members                                                  //
+			// -------------------------------------------------------------- //
+			tree_type		_tree;
+			allocator_type	_alloc;
+			key_compare		_comp;
+
+			static typename tree_type::iterator	_treeIterator(const_iterator it)
+			{
+				return typename tree_type::iterator(it.getNode());
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors                                                  //
+			// -------------------------------------------------------------- //
+			explicit set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+				_tree(comp, alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{}
+
+			template <class InputIterator>
+			set(
+				InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()
+			):
+				_tree(comp, alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{
+				_tree.insert(first, last);
+			}
+
+			set(const set& x):
+				_tree(x._tree),
+				_alloc(_tree.get_allocator()),
+				_comp(x._comp)
+			{}
+
+			set& operator=(const set& x)
+			{
+				_tree = x._tree;
+				_alloc = _tree.get_allocator();
+				_comp = x._comp;
+				return *this;
+			}
+
+			// --- Destructor --- //
+			~set()
+			{}
+
+			allocator_type	get_allocator() const
+			{
+				return _alloc;
+			}
+
+			key_compare	key_comp() const
+			{
+				return _comp;
+			}
+
+			value_compare	value_comp() const
+			{
+				return _comp;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Iterators                                                     //
+			// -------------------------------------------------------------- //
+			iterator begin() const
+			{
+				return _tree.begin();
+			}
+
+			iterator end() const
+			{
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin() const
+			{
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend() const
+			{
+				return _tree.rend();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Capacity --- //
+			bool empty() const
+			{
+				return _tree.size() == 0;
+			}
+
+			size_type size() const
+			{
+				return _tree.size();
+			}
+
+			size_type max_size() const
+			{
+				return _alloc.max_size();
+			}
+
+			// --- Statistics --- //
+			ft::container_stats	stats() const
+			{
+				return _tree.stats();
+			}
+
+			void	reset_stats()
+			{
+				_tree.reset_stats();
+			}
+
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage = _tree.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				_tree.clear();
+			}
+
+			void	swap(set& other)
+			{
+				_tree.swap(other._tree);
+				std::swap(_alloc, other._alloc);
+				std::swap(_comp, other._comp);
+			}
+
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				ft::pair<typename tree_type::iterator, bool>	result = _tree.insert(val);
+
+				return ft::make_pair(iterator(result.first.getNode()), result.second);
+			}
+
+			template <class InputIterator>
+			void	insert(InputIterator first, InputIterator last)
+			{
+				_tree.insert(first, last);
+			}
+
+			void	erase(iterator pos)
+			{
+				_tree.remove(_treeIterator(pos));
+			}
+
+			size_type	erase(const key_type& key)
+			{
+				return _tree.remove(key);
+			}
+
+			// O(k + log n) for k erased elements, see RBTree::remove
+			void	erase(iterator first, iterator last)
+			{
+				_tree.remove(_treeIterator(first), _treeIterator(last));
+			}
+
+			// --- Split / join --- //
+			// See map::split and map::join
+
+			void	split(const key_type& key, set& right)
+			{
+				_tree.split(key, right._tree);
+			}
+
+			void	join(set& right)
+			{
+				_tree.join(right._tree);
+			}
+
+			// --- Lookup --- //
+			size_type	count(const key_type& key) const
+			{
+				return _tree.search(key) == nullptr ? 0 : 1;
+			}
+
+			iterator	find(const key_type& key) const
+			{
+				typename tree_type::node_pointer	node = _tree.search(key);
+
+				return node == nullptr ? end() : iterator(node);
+			}
+
+			iterator	lower_bound(const key_type& key) const
+			{
+				return iterator(_tree.lowerBound(key));
+			}
+
+			iterator	upper_bound(const key_type& key) const
+			{
+				return iterator(_tree.upperBound(key));
+			}
+
+			ft::pair<iterator, iterator>	equal_range(const key_type& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+	};
+
+	// Same as ft::set, but equivalent keys may be inserted several times.
+	// They are kept in insertion order.
+	template <
+		class Key,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<Key>
+	>
+	class multiset
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef Key											key_type;
+			typedef Key											value_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef Compare										key_compare;
+			typedef Compare										value_compare;
+			typedef Allocator									allocator_type;
+
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+
+		private:
+			typedef ft::RBTree<value_type, key_compare, allocator_type>	tree_type;
+
+		public:
+			// --- Iterator types --- //
+			typedef typename tree_type::const_iterator			iterator;
+			typedef typename tree_type::const_iterator			const_iterator;
+			typedef typename tree_type::const_reverse_iterator	reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator	const_reverse_iterator;
+
+		private:
+			// -------------------------------------------------------------- //
+			//  Data members                                                  //
+			// -------------------------------------------------------------- //
+			tree_type		_tree;
+			allocator_type	_alloc;
+			key_compare		_comp;
+
+			static typename tree_type::iterator	_treeIterator(const_iterator it)
+			{
+				return typename tree_type::iterator(it.getNode());
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors                                                  //
+			// -------------------------------------------------------------- //
+			explicit multiset(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+				_tree(comp, alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{}
+
+			template <class InputIterator>
+			multiset(
+				InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()
+			):
+				_tree(comp, alloc),
+				_alloc(alloc),
+				_comp(comp)
+			{
+				insert(first, last);
+			}
+
+			multiset(const multiset& x):
+				_tree(x._tree),
+				_alloc(_tree.get_allocator()),
+				_comp(x._comp)
+			{}
+
+			multiset& operator=(const multiset& x)
+			{
+				_tree = x._tree;
+				_alloc = _tree.get_allocator();
+				_comp = x._comp;
+				return *this;
+			}
+
+			// --- Destructor --- //
+			~multiset()
+			{}
+
+			allocator_type	get_allocator() const
+			{
+				return _alloc;
+			}
+
+			key_compare	key_comp() const
+			{
+				return _comp;
+			}
+
+			value_compare	value_comp() const
+			{
+				return _comp;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Iterators                                                     //
+			// -------------------------------------------------------------- //
+			iterator begin() const
+			{
+				return _tree.begin();
+			}
+
+			iterator end() const
+			{
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin() const
+			{
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend() const
+			{
+				return _tree.rend();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Capacity --- //
+			bool empty() const
+			{
+				return _tree.size() == 0;
+			}
+
+			size_type size() const
+			{
+				return _tree.size();
+			}
+
+			size_type max_size() const
+			{
+				return _alloc.max_size();
+			}
+
+			// --- Statistics --- //
+			ft::container_stats	stats() const
+			{
+				return _tree.stats();
+			}
+
+			void	reset_stats()
+			{
+				_tree.reset_stats();
+			}
+
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage = _tree.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				_tree.clear();
+			}
+
+			void	swap(multiset& other)
+			{
+				_tree.swap(other._tree);
+				std::swap(_alloc, other._alloc);
+				std::swap(_comp, other._comp);
+			}
+
+			iterator	insert(const value_type& val)
+			{
+				return iterator(_tree.insertMulti(val).getNode());
+			}
+
+			template <class InputIterator>
+			void	insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					_tree.insertMulti(*first);
+			}
+
+			void	erase(iterator pos)
+			{
+				_tree.remove(_treeIterator(pos));
+			}
+
+			// Erases all the elements equivalent to key
+			size_type	erase(const key_type& key)
+			{
+				return _tree.remove(key);
+			}
+
+			// O(k + log n) for k erased elements, see RBTree::remove
+			void	erase(iterator first, iterator last)
+			{
+				_tree.remove(_treeIterator(first), _treeIterator(last));
+			}
+
+			// --- Split / join --- //
+			// See map::split and map::join. Elements of right equivalent to
+			// the last element of this multiset still join in O(log n).
+
+			void	split(const key_type& key, multiset& right)
+			{
+				_tree.split(key, right._tree);
+			}
+
+			void	join(multiset& right)
+			{
+				_tree.join(right._tree, true);
+			}
+
+			// --- Lookup --- //
+			// O(log n) whatever the number of duplicates, using the subtree
+			// counts of the tree
+			size_type	count(const key_type& key) const
+			{
+				return _tree.rank(_treeIterator(upper_bound(key))) - _tree.rank(_treeIterator(lower_bound(key)));
+			}
+
+			// First of the equivalent elements
+			iterator	find(const key_type& key) const
+			{
+				typename tree_type::node_pointer	node = _tree.search(key);
+
+				return node == nullptr ? end() : iterator(node);
+			}
+
+			iterator	lower_bound(const key_type& key) const
+			{
+				return iterator(_tree.lowerBound(key));
+			}
+
+			iterator	upper_bound(const key_type& key) const
+			{
+				return iterator(_tree.upperBound(key));
+			}
+
+			ft::pair<iterator, iterator>	equal_range(const key_type& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+	};
+
+	// --- Set comparisons --- //
+	template <class Key, class Compare, class Alloc>
+	bool	operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	{
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+	// --- Multiset comparisons --- //
+	template <class Key, class Compare, class Alloc>
+	bool	operator==(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator!=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+}
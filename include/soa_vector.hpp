@@ -0,0 +1,476 @@
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#include "vector.hpp"
+#include "pair.hpp"
+#include "soa_vector_iterator.hpp"
+#include "stats.hpp"
+
+namespace ft
+{
+
+	// Type of the elements of a column. ft::vector<bool> packs its bits,
+	// which leaves no bool to refer to nor array to hand out: a bool field
+	// has no column, and soa_vector<A, bool> does not compile. Store it as
+	// a char instead.
+	template <class T>
+	struct soa_column_element
+	{
+		typedef T	type;
+	};
+
+	template <>
+	struct soa_column_element<bool>;
+
+	// --- SoA Vector class --- //
+	// A sequence of ft::pair<A, B> records stored as a structure of arrays:
+	// the first fields in one ft::vector, the second fields in another, both
+	// indexed alike. A scan over the first fields only loads first fields,
+	// and the columns, given by first_data() and second_data(), are plain
+	// arrays the compiler can vectorize over.
+	//
+	// The interface is ft::vector's, with records built from a pair or from
+	// both fields. Since no pair is stored, iterators yield a
+	// ft::soa_reference proxy, whose first and second members refer to the
+	// fields in the columns. Neither field may be a bool, see above.
+	template < class A, class B, class Allocator = std::allocator< ft::pair<A, B> > >
+	class soa_vector
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef ft::pair<A, B>											value_type;
+			typedef A														first_type;
+			typedef B														second_type;
+			typedef Allocator												allocator_type;
+			typedef soa_reference<A, B>										reference;
+			typedef soa_reference<const A, const B>							const_reference;
+			typedef std::ptrdiff_t											difference_type;
+			typedef std::size_t												size_type;
+
+			typedef typename Allocator::template rebind<A>::other			first_allocator_type;
+			typedef typename Allocator::template rebind<B>::other			second_allocator_type;
+			typedef ft::vector<typename soa_column_element<A>::type, first_allocator_type>	first_column_type;
+			typedef ft::vector<typename soa_column_element<B>::type, second_allocator_type>	second_column_type;
+
+			// --- Iterator types --- //
+			typedef soa_iterator<A, B, A, B>								iterator;
+			typedef soa_iterator<A, B, const A, const B>					const_iterator;
+			typedef ft::reverse_iterator<iterator>							reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+		private:
+			// -------------------------------------------------------------- //
+			//  Member variables                                              //
+			// -------------------------------------------------------------- //
+			first_column_type	_first;		// First fields
+			second_column_type	_second;	// Second fields, same size as _first
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			typename first_column_type::iterator	firstAt(size_type index)
+			{
+				return (_first.begin() + index);
+			}
+
+			typename second_column_type::iterator	secondAt(size_type index)
+			{
+				return (_second.begin() + index);
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + copying                            //
+			// -------------------------------------------------------------- //
+			// --- Default constructor --- //
+			soa_vector(void)
+			{}
+
+			// --- Constructor with allocator --- //
+			explicit soa_vector(const allocator_type &alloc):
+				_first(first_allocator_type(alloc)),
+				_second(second_allocator_type(alloc))
+			{}
+
+			// --- Constructor with count and value --- //
+			explicit soa_vector(size_type count, const value_type &value = value_type(), const allocator_type &alloc = Allocator()):
+				_first(count, value.first, first_allocator_type(alloc)),
+				_second(count, value.second, second_allocator_type(alloc))
+			{}
+
+			// --- Constructor from iterators --- //
+			template < class InputIt >
+			soa_vector(InputIt first, InputIt last, const allocator_type &alloc = Allocator(), typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0):
+				_first(first_allocator_type(alloc)),
+				_second(second_allocator_type(alloc))
+			{
+				insert(end(), first, last);
+			}
+
+			// --- Copy constructor --- //
+			soa_vector(const soa_vector &other):
+				_first(other._first),
+				_second(other._second)
+			{}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			soa_vector	&operator=(const soa_vector &other)
+			{
+				_first = other._first;
+				_second = other._second;
+				return (*this);
+			}
+
+			void	assign(size_type count, const value_type &value)
+			{
+				clear();
+				insert(end(), count, value);
+			}
+
+			template < class InputIt >
+			void	assign(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				clear();
+				insert(end(), first, last);
+			}
+
+			allocator_type	get_allocator(void) const
+			{
+				return (allocator_type(_first.get_allocator()));
+			}
+
+			// --- Element access --- //
+			reference at(size_type pos)
+			{
+				if (pos >= size())
+					throw std::out_of_range("soa_vector::at");
+				return ((*this)[pos]);
+			}
+
+			const_reference at(size_type pos) const
+			{
+				if (pos >= size())
+					throw std::out_of_range("soa_vector::at");
+				return ((*this)[pos]);
+			}
+
+			reference	operator[](size_type pos)
+			{
+				return (reference(_first[pos], _second[pos]));
+			}
+
+			const_reference	operator[](size_type pos) const
+			{
+				return (const_reference(_first[pos], _second[pos]));
+			}
+
+			reference	front(void)
+			{
+				return ((*this)[0]);
+			}
+
+			const_reference	front(void) const
+			{
+				return ((*this)[0]);
+			}
+
+			reference	back(void)
+			{
+				return ((*this)[size() - 1]);
+			}
+
+			const_reference	back(void) const
+			{
+				return ((*this)[size() - 1]);
+			}
+
+			// --- Columns --- //
+			A	*first_data(void)
+			{
+				return (_first.data());
+			}
+
+			const A	*first_data(void) const
+			{
+				return (_first.data());
+			}
+
+			B	*second_data(void)
+			{
+				return (_second.data());
+			}
+
+			const B	*second_data(void) const
+			{
+				return (_second.data());
+			}
+
+			const first_column_type	&first_column(void) const
+			{
+				return (_first);
+			}
+
+			const second_column_type	&second_column(void) const
+			{
+				return (_second);
+			}
+
+			// --- Iterators --- //
+			iterator	begin(void)
+			{
+				return (iterator(_first.data(), _second.data()));
+			}
+
+			const_iterator	begin(void) const
+			{
+				return (const_iterator(_first.data(), _second.data()));
+			}
+
+			iterator	end(void)
+			{
+				return (begin() + size());
+			}
+
+			const_iterator	end(void) const
+			{
+				return (begin() + size());
+			}
+
+			reverse_iterator	rbegin(void)
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin(void) const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend(void)
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend(void) const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			// --- Capacity --- //
+			size_type	size(void) const
+			{
+				return (_first.size());
+			}
+
+			size_type	max_size(void) const
+			{
+				return (std::min(_first.max_size(), _second.max_size()));
+			}
+
+			void	reserve(size_type new_cap)
+			{
+				_first.reserve(new_cap);
+				_second.reserve(new_cap);
+			}
+
+			size_type	capacity(void) const
+			{
+				return (std::min(_first.capacity(), _second.capacity()));
+			}
+
+			bool	empty(void) const
+			{
+				return (_first.empty());
+			}
+
+			// --- Statistics --- //
+			// Counters of both columns added up, only filled when built with
+			// FT_STATS.
+			ft::container_stats	stats(void) const
+			{
+				ft::container_stats	stats = _first.stats();
+				ft::container_stats	second = _second.stats();
+
+				stats.reallocations += second.reallocations;
+				stats.relocations += second.relocations;
+				stats.bytes_relocated += second.bytes_relocated;
+				stats.capacity = capacity();
+				return (stats);
+			}
+
+			// Both column buffers, see ft::memory_usage
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage = _first.memory_usage();
+				ft::memory_usage	second = _second.memory_usage();
+
+				usage.payload += second.payload;
+				usage.reserved += second.reserved;
+				usage.allocations += second.allocations;
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				_first.clear();
+				_second.clear();
+			}
+
+			// The columns grow one after the other, the first one is rolled
+			// back when the second one throws.
+			void	push_back(const first_type &first, const second_type &second)
+			{
+				_first.push_back(first);
+				try
+				{
+					_second.push_back(second);
+				}
+				catch (...)
+				{
+					_first.pop_back();
+					throw;
+				}
+			}
+
+			void	push_back(const value_type &value)
+			{
+				push_back(value.first, value.second);
+			}
+
+			void	pop_back(void)
+			{
+				_first.pop_back();
+				_second.pop_back();
+			}
+
+			iterator	insert(iterator pos, const value_type &value)
+			{
+				return (insert(pos, 1, value));
+			}
+
+			iterator	insert(iterator pos, size_type count, const value_type &value)
+			{
+				size_type	index = pos - begin();
+
+				_first.insert(firstAt(index), count, value.first);
+				try
+				{
+					_second.insert(secondAt(index), count, value.second);
+				}
+				catch (...)
+				{
+					_first.erase(firstAt(index), firstAt(index + count));
+					throw;
+				}
+				return (begin() + index);
+			}
+
+			// Records may be pairs or soa_reference proxies, they are read
+			// once, field by field, after both columns made room for them.
+			template < class InputIt >
+			iterator	insert(iterator pos, InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				size_type	index = pos - begin();
+				size_type	count = std::distance(first, last);
+
+				if (count == 0)
+					return (pos);
+				insert(pos, count, value_type());
+				for (size_type i = index; i < index + count; ++i, ++first)
+				{
+					value_type	record = *first;
+
+					_first[i] = record.first;
+					_second[i] = record.second;
+				}
+				return (begin() + index);
+			}
+
+			iterator	erase(iterator pos)
+			{
+				return (erase(pos, pos + 1));
+			}
+
+			iterator	erase(iterator first, iterator last)
+			{
+				size_type	index = first - begin();
+				size_type	count = last - first;
+
+				_first.erase(firstAt(index), firstAt(index + count));
+				_second.erase(secondAt(index), secondAt(index + count));
+				return (begin() + index);
+			}
+
+			void	resize(size_type newSize, value_type value = value_type())
+			{
+				_first.resize(newSize, value.first);
+				try
+				{
+					_second.resize(newSize, value.second);
+				}
+				catch (...)
+				{
+					_first.resize(_second.size());
+					throw;
+				}
+			}
+
+			void	swap(soa_vector &other)
+			{
+				_first.swap(other._first);
+				_second.swap(other._second);
+			}
+	};
+
+	template < class A, class B, class Alloc >
+	bool	operator==(const soa_vector<A,B,Alloc>& lhs, const soa_vector<A,B,Alloc>& rhs)
+	{
+		return (lhs.first_column() == rhs.first_column() && lhs.second_column() == rhs.second_column());
+	}
+
+	template < class A, class B, class Alloc >
+	bool	operator!=(const soa_vector<A,B,Alloc>& lhs, const soa_vector<A,B,Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template < class A, class B, class Alloc >
+	bool	operator<(const soa_vector<A,B,Alloc>& lhs, const soa_vector<A,B,Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template < class A, class B, class Alloc >
+	bool	operator>=(const soa_vector<A,B,Alloc>& lhs, const soa_vector<A,B,Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template < class A, class B, class Alloc >
+	bool	operator<=(const soa_vector<A,B,Alloc>& lhs, const soa_vector<A,B,Alloc>& rhs)
+	{
+		return (lhs < rhs || lhs == rhs);
+	}
+
+	template < class A, class B, class Alloc >
+	bool	operator>(const soa_vector<A,B,Alloc>& lhs, const soa_vector<A,B,Alloc>& rhs)
+	{
+		return (!(lhs <= rhs));
+	}
+
+	template < class A, class B, class Alloc >
+	void	swap(soa_vector<A,B,Alloc>& lhs, soa_vector<A,B,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
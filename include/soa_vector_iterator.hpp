@@ -0,0 +1,310 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <algorithm>
+
+#include "pair.hpp"
+
+namespace ft
+{
+
+	// --- SoA reference --- //
+	// Stands for a record of a ft::soa_vector, whose fields are stored apart:
+	// it refers to one slot of each column. Reads and writes go through to
+	// the columns, assigning to it never rebinds it. First and Second are
+	// const for the const_iterator.
+	template <class First, class Second>
+	class soa_reference
+	{
+		public:
+			typedef First	first_type;
+			typedef Second	second_type;
+
+			first_type	&first;
+			second_type	&second;
+
+			soa_reference(first_type &f, second_type &s):
+				first(f),
+				second(s)
+			{}
+
+			soa_reference(const soa_reference &other):
+				first(other.first),
+				second(other.second)
+			{}
+
+			// Converts a mutable reference to a const one
+			template <class F, class S>
+			soa_reference(const soa_reference<F, S> &other):
+				first(other.first),
+				second(other.second)
+			{}
+
+			template <class U, class V>
+			operator ft::pair<U, V>() const
+			{
+				return (ft::pair<U, V>(first, second));
+			}
+
+			// Writes the fields
+			soa_reference &operator=(const soa_reference &other)
+			{
+				first = other.first;
+				second = other.second;
+				return (*this);
+			}
+
+			template <class U, class V>
+			soa_reference &operator=(const ft::pair<U, V> &value)
+			{
+				first = value.first;
+				second = value.second;
+				return (*this);
+			}
+
+			// Swaps the fields the references point to, for std algorithms
+			friend void	swap(soa_reference lhs, soa_reference rhs)
+			{
+				std::swap(lhs.first, rhs.first);
+				std::swap(lhs.second, rhs.second);
+			}
+	};
+
+	template <class F1, class S1, class F2, class S2>
+	bool	operator==(const soa_reference<F1, S1> &lhs, const soa_reference<F2, S2> &rhs)
+	{
+		return (lhs.first == rhs.first && lhs.second == rhs.second);
+	}
+
+	template <class F1, class S1, class F2, class S2>
+	bool	operator!=(const soa_reference<F1, S1> &lhs, const soa_reference<F2, S2> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class F1, class S1, class F2, class S2>
+	bool	operator<(const soa_reference<F1, S1> &lhs, const soa_reference<F2, S2> &rhs)
+	{
+		return (lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second));
+	}
+
+	// Against records held by value, e.g. by std::sort
+	template <class F, class S, class U, class V>
+	bool	operator==(const soa_reference<F, S> &lhs, const ft::pair<U, V> &rhs)
+	{
+		return (lhs.first == rhs.first && lhs.second == rhs.second);
+	}
+
+	template <class U, class V, class F, class S>
+	bool	operator==(const ft::pair<U, V> &lhs, const soa_reference<F, S> &rhs)
+	{
+		return (rhs == lhs);
+	}
+
+	template <class F, class S, class U, class V>
+	bool	operator<(const soa_reference<F, S> &lhs, const ft::pair<U, V> &rhs)
+	{
+		return (lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second));
+	}
+
+	template <class U, class V, class F, class S>
+	bool	operator<(const ft::pair<U, V> &lhs, const soa_reference<F, S> &rhs)
+	{
+		return (lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second));
+	}
+
+	// --- SoA arrow --- //
+	// Result of operator->, keeps the proxy alive for the member access
+	template <class Reference>
+	class soa_arrow
+	{
+		private:
+			Reference	_ref;
+
+		public:
+			soa_arrow(const Reference &ref):
+				_ref(ref)
+			{}
+
+			Reference	*operator->()
+			{
+				return (&_ref);
+			}
+	};
+
+	// --- SoA Iterator class --- //
+	// One pointer per column, moved together. A and B are the field types,
+	// First and Second the same ones, const qualified for the const_iterator.
+	template <class A, class B, class First, class Second>
+	class soa_iterator
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef std::random_access_iterator_tag		iterator_category;
+			typedef ft::pair<A, B>						value_type;
+			typedef std::ptrdiff_t						difference_type;
+			typedef soa_reference<First, Second>		reference;
+			typedef soa_arrow<reference>				pointer;
+
+		private:
+			First	*_first;
+			Second	*_second;
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + assignment                         //
+			// -------------------------------------------------------------- //
+			soa_iterator():
+				_first(NULL),
+				_second(NULL)
+			{}
+
+			soa_iterator(First *first, Second *second):
+				_first(first),
+				_second(second)
+			{}
+
+			// --- Conversion from iterator --- //
+			template <class F, class S>
+			soa_iterator(const soa_iterator<A, B, F, S> &other):
+				_first(other.firstPtr()),
+				_second(other.secondPtr())
+			{}
+
+			First	*firstPtr(void) const
+			{
+				return (_first);
+			}
+
+			Second	*secondPtr(void) const
+			{
+				return (_second);
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return (reference(*_first, *_second));
+			}
+
+			pointer operator->() const
+			{
+				return (pointer(**this));
+			}
+
+			reference operator[](difference_type n) const
+			{
+				return (reference(_first[n], _second[n]));
+			}
+
+			// --- Increment / decrement --- //
+			soa_iterator &operator++() // ++it
+			{
+				++_first;
+				++_second;
+				return (*this);
+			}
+
+			soa_iterator operator++(int) // it++
+			{
+				soa_iterator tmp(*this);
+				++*this;
+				return (tmp);
+			}
+
+			soa_iterator &operator--() // --it
+			{
+				--_first;
+				--_second;
+				return (*this);
+			}
+
+			soa_iterator operator--(int) // it--
+			{
+				soa_iterator tmp(*this);
+				--*this;
+				return (tmp);
+			}
+
+			// --- Arithmetic --- //
+			soa_iterator &operator+=(difference_type n) // it += n
+			{
+				_first += n;
+				_second += n;
+				return (*this);
+			}
+
+			soa_iterator &operator-=(difference_type n) // it -= n
+			{
+				return (*this += -n);
+			}
+
+			soa_iterator operator+(difference_type n) const // it + n
+			{
+				soa_iterator tmp(*this);
+				return (tmp += n);
+			}
+
+			soa_iterator operator-(difference_type n) const // it - n
+			{
+				soa_iterator tmp(*this);
+				return (tmp -= n);
+			}
+
+			friend soa_iterator operator+(difference_type n, const soa_iterator &it)
+			{
+				return (it + n);
+			}
+
+			// --- Difference and comparison --- //
+			// The first column alone tells the position
+			template <class F, class S>
+			difference_type operator-(const soa_iterator<A, B, F, S> &other) const // it - other
+			{
+				return (_first - other.firstPtr());
+			}
+
+			template <class F, class S>
+			bool operator==(const soa_iterator<A, B, F, S> &other) const // it == other
+			{
+				return (_first == other.firstPtr());
+			}
+
+			template <class F, class S>
+			bool operator!=(const soa_iterator<A, B, F, S> &other) const // it != other
+			{
+				return (_first != other.firstPtr());
+			}
+
+			template <class F, class S>
+			bool operator<(const soa_iterator<A, B, F, S> &other) const // it < other
+			{
+				return (_first < other.firstPtr());
+			}
+
+			template <class F, class S>
+			bool operator<=(const soa_iterator<A, B, F, S> &other) const // it <= other
+			{
+				return (_first <= other.firstPtr());
+			}
+
+			template <class F, class S>
+			bool operator>(const soa_iterator<A, B, F, S> &other) const // it > other
+			{
+				return (_first > other.firstPtr());
+			}
+
+			template <class F, class S>
+			bool operator>=(const soa_iterator<A, B, F, S> &other) const // it >= other
+			{
+				return (_first >= other.firstPtr());
+			}
+	};
+
+}
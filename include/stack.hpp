@@ -42,12 +42,19 @@ namespace ft
 				c(cont)
 			{}
 
+			// Builds the underlying container with the given allocator, e.g. a
+			// ft::pmr::polymorphic_allocator bound to an arena
+			template <class Alloc>
+			explicit stack(const Alloc& alloc):
+				c(alloc)
+			{}
+
 			stack(const stack& other):					// Copy constructor
 				c(other.c)
 			{}
 
 			stack&	operator=(const stack& other)		// Copy assignment operator
-			{ c = other.c; }
+			{ c = other.c; return *this; }
 
 			bool			empty(void) const
 			{ return c.empty(); }
@@ -67,6 +74,17 @@ namespace ft
 			void			pop(void)
 			{ c.pop_back(); }
 
+			ft::container_stats	stats(void) const	// Statistics of the underlying container
+			{ return c.stats(); }
+
+			ft::memory_usage	memory_usage(void) const	// Footprint of the underlying container
+			{
+				ft::memory_usage	usage = c.memory_usage();
+
+				usage.object = sizeof(*this);
+				return usage;
+			}
+
 	};
 
 }
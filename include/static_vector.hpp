@@ -0,0 +1,629 @@
+#pragma once
+
+#include <new>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "iterators.hpp"
+#include "vector_iterator.hpp"
+#include "utility.hpp"
+#include "stats.hpp"
+#include "is_trivially_copyable.hpp"
+
+namespace ft
+{
+
+	// --- Static Vector class --- //
+	// Same interface as ft::vector, but the elements live in uninitialized
+	// storage inside the object, room for N of them: nothing is ever
+	// allocated, and nothing is stored per element. Growing past N throws
+	// std::length_error and leaves the vector untouched; try_push_back()
+	// reports it instead, for code that cannot throw. Element copies that
+	// throw leave no element behind, and an insertion they interrupt puts
+	// back the elements it had shifted when it can.
+	//
+	// Trivially copyable elements are copied, moved and swapped as raw
+	// bytes, a copy being a single memcpy of the live elements.
+	template < class T, std::size_t N >
+	class static_vector: public ft::stats_policy
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef T										value_type;
+			typedef T&										reference;
+			typedef const T&								const_reference;
+			typedef T*										pointer;
+			typedef const T*								const_pointer;
+			typedef std::ptrdiff_t							difference_type;
+			typedef std::size_t								size_type;
+
+			// --- Iterator types --- //
+			typedef vector_iterator<value_type>				iterator;
+			typedef vector_iterator<const value_type>		const_iterator;
+			typedef ft::reverse_iterator<iterator>			reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+			static const size_type	static_capacity = N;
+
+		private:
+			static const bool	trivial = ft::is_trivially_copyable<T>::value;
+
+			// -------------------------------------------------------------- //
+			//  Member variables                                              //
+			// -------------------------------------------------------------- //
+			size_type					_size;		// Number of elements
+			alignas(T) unsigned char	_storage[N ? N * sizeof(T) : 1];	// Room for N elements
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			pointer	_ptr(void)
+			{
+				return (reinterpret_cast<pointer>(_storage));
+			}
+
+			const_pointer	_ptr(void) const
+			{
+				return (reinterpret_cast<const_pointer>(_storage));
+			}
+
+			void	checkRoom(size_type count, const char *what) const
+			{
+				if (count > N - _size)
+					throw std::length_error(what);
+			}
+
+			// Copies count elements into raw slots, destroying the ones
+			// already built when a copy throws
+			template < class InputIt >
+			void	constructRange(pointer dest, InputIt first, size_type count)
+			{
+				size_type	i = 0;
+
+				try
+				{
+					for (; i < count; ++i, ++first)
+						new (dest + i) value_type(*first);
+				}
+				catch (...)
+				{
+					destroyRange(dest, dest + i);
+					throw;
+				}
+			}
+
+			void	destroyRange(pointer first, pointer last)
+			{
+				if (trivial)
+					return ;
+				while (first != last)
+					(first++)->~value_type();
+			}
+
+			// Shifts [index, _size) right by count, leaving count raw slots
+			// at index. Only trivially copyable elements may be shifted
+			// bytewise, the others are rebuilt in place.
+			void	openGap(size_type index, size_type count)
+			{
+				pointer	ptr = _ptr();
+
+				countRelocations(_size - index, sizeof(value_type));
+				if (trivial)
+				{
+					std::memmove(static_cast<void *>(ptr + index + count), ptr + index,
+						(_size - index) * sizeof(value_type));
+					return ;
+				}
+
+				size_type	i = _size;
+
+				try
+				{
+					for (; i > index; --i)
+					{
+						if (i - 1 + count >= _size)
+							new (ptr + i - 1 + count) value_type(ptr[i - 1]);
+						else
+							ptr[i - 1 + count] = ptr[i - 1];
+					}
+				}
+				catch (...)
+				{
+					// Only the slots past the end are dropped, the vector
+					// keeps its size
+					destroyRange(ptr + std::max(_size, i + count), ptr + _size + count);
+					throw;
+				}
+				destroyRange(ptr + index, ptr + std::min(index + count, _size));
+			}
+
+			// Undoes openGap(index, count) after a copy into the gap threw,
+			// built elements having been constructed there. The elements past
+			// the gap are copied back; should that throw too, only the ones
+			// before index are kept.
+			void	abandonGap(size_type index, size_type count, size_type built)
+			{
+				pointer		ptr = _ptr();
+				size_type	moved = 0;
+
+				destroyRange(ptr + index, ptr + index + built);
+				try
+				{
+					for (; moved < _size - index; ++moved)
+					{
+						if (moved < count)
+							new (ptr + index + moved) value_type(ptr[index + count + moved]);
+						else
+							ptr[index + moved] = ptr[index + count + moved];
+					}
+				}
+				catch (...)
+				{
+					destroyRange(ptr + index, ptr + index + std::min(moved, count));
+					destroyRange(ptr + index + count, ptr + _size + count);
+					_size = index;
+					return ;
+				}
+				destroyRange(ptr + std::max(_size, index + count), ptr + _size + count);
+			}
+
+			// Shifts [index + count, _size) left by count over the erased
+			// elements
+			void	closeGap(size_type index, size_type count)
+			{
+				pointer	ptr = _ptr();
+
+				if (count == 0)
+					return ;
+				if (trivial)
+					std::memmove(static_cast<void *>(ptr + index), ptr + index + count,
+						(_size - index - count) * sizeof(value_type));
+				else
+				{
+					std::copy(ptr + index + count, ptr + _size, ptr + index);
+					destroyRange(ptr + _size - count, ptr + _size);
+				}
+				_size -= count;
+			}
+
+			void	copyFrom(const static_vector &other)
+			{
+				if (trivial)
+					std::memcpy(static_cast<void *>(_storage), other._storage, other._size * sizeof(value_type));
+				else
+					constructRange(_ptr(), other._ptr(), other._size);
+				_size = other._size;
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + copying                            //
+			// -------------------------------------------------------------- //
+			// --- Default constructor --- //
+			static_vector(void):
+				_size(0)
+			{}
+
+			// --- Constructor with count and value --- //
+			explicit static_vector(size_type count, const value_type& value = value_type()):
+				_size(0)
+			{
+				assign(count, value);
+			}
+
+			// --- Constructor from iterators --- //
+			template < class InputIt >
+			static_vector(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0):
+				_size(0)
+			{
+				assign(first, last);
+			}
+
+			// --- Copy constructor --- //
+			static_vector(const static_vector &other):
+				_size(0)
+			{
+				copyFrom(other);
+			}
+
+			// --- Destructor --- //
+			~static_vector(void)
+			{
+				clear();
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			static_vector	&operator=(const static_vector& other)
+			{
+				if (this == &other)
+					return (*this);
+
+				if (trivial)
+					copyFrom(other);
+				else if (other._size > _size)
+				{
+					std::copy(other._ptr(), other._ptr() + _size, _ptr());
+					constructRange(_ptr() + _size, other._ptr() + _size, other._size - _size);
+					_size = other._size;
+				}
+				else
+				{
+					std::copy(other._ptr(), other._ptr() + other._size, _ptr());
+					destroyRange(_ptr() + other._size, _ptr() + _size);
+					_size = other._size;
+				}
+				return (*this);
+			}
+
+			void	assign(size_type count, const value_type& value)
+			{
+				if (count > N)
+					throw std::length_error("static_vector::assign");
+
+				value_type	copy(value);	// value may be one of the elements
+
+				clear();
+				for (; _size < count; ++_size)
+					new (_ptr() + _size) value_type(copy);
+			}
+
+			template < class InputIt >
+			void	assign(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				size_type	count = std::distance(first, last);
+
+				if (count > N)
+					throw std::length_error("static_vector::assign");
+				clear();
+				constructRange(_ptr(), first, count);
+				_size = count;
+			}
+
+			// --- Element access --- //
+			reference at(size_type pos)
+			{
+				if (pos >= _size)
+					throw std::out_of_range("static_vector::at");
+				return (_ptr()[pos]);
+			}
+
+			const_reference at(size_type pos) const
+			{
+				if (pos >= _size)
+					throw std::out_of_range("static_vector::at");
+				return (_ptr()[pos]);
+			}
+
+			reference	operator[](size_type pos)
+			{
+				return (_ptr()[pos]);
+			}
+
+			const_reference	operator[](size_type pos) const
+			{
+				return (_ptr()[pos]);
+			}
+
+			reference	front(void)
+			{
+				return (*_ptr());
+			}
+
+			const_reference	front(void) const
+			{
+				return (*_ptr());
+			}
+
+			reference	back(void)
+			{
+				return (_ptr()[_size - 1]);
+			}
+
+			const_reference	back(void) const
+			{
+				return (_ptr()[_size - 1]);
+			}
+
+			pointer	data(void)
+			{
+				return (_ptr());
+			}
+
+			const_pointer	data(void) const
+			{
+				return (_ptr());
+			}
+
+			// --- Iterators --- //
+			iterator	begin(void)
+			{
+				return (iterator(_ptr()));
+			}
+
+			const_iterator	begin(void) const
+			{
+				return (const_iterator(_ptr()));
+			}
+
+			iterator	end(void)
+			{
+				return (iterator(_ptr() + _size));
+			}
+
+			const_iterator	end(void) const
+			{
+				return (const_iterator(_ptr() + _size));
+			}
+
+			reverse_iterator	rbegin(void)
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin(void) const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend(void)
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend(void) const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			// --- Capacity --- //
+			size_type	size(void) const
+			{
+				return (_size);
+			}
+
+			size_type	max_size(void) const
+			{
+				return (N);
+			}
+
+			// Nothing to allocate, only checks that new_cap fits
+			void	reserve(size_type new_cap)
+			{
+				if (new_cap > N)
+					throw std::length_error("static_vector::reserve");
+			}
+
+			size_type	capacity(void) const
+			{
+				return (N);
+			}
+
+			bool	empty(void) const
+			{
+				return (_size == 0);
+			}
+
+			bool	full(void) const
+			{
+				return (_size == N);
+			}
+
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS.
+			ft::container_stats	stats(void) const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = N;
+				return (stats);
+			}
+
+			// The storage is part of the object, nothing is on the heap
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				destroyRange(_ptr(), _ptr() + _size);
+				_size = 0;
+			}
+
+			void	push_back(const value_type& value)
+			{
+				checkRoom(1, "static_vector::push_back");
+				new (_ptr() + _size) value_type(value);
+				++_size;
+			}
+
+			// Same as push_back, but returns false rather than throwing when
+			// the vector is full
+			bool	try_push_back(const value_type& value)
+			{
+				if (_size == N)
+					return (false);
+				new (_ptr() + _size) value_type(value);
+				++_size;
+				return (true);
+			}
+
+			void	pop_back(void)
+			{
+				if (_size == 0)
+					return ;
+				--_size;
+				destroyRange(_ptr() + _size, _ptr() + _size + 1);
+			}
+
+			iterator	insert(iterator pos, const value_type& value)
+			{
+				return (insert(pos, 1, value));
+			}
+
+			// The value is copied first, it may be one of the elements moved
+			iterator	insert(iterator pos, size_type count, const value_type& value)
+			{
+				size_type	index = pos - begin();
+
+				checkRoom(count, "static_vector::insert");
+				if (count == 0)
+					return (pos);
+
+				value_type	copy(value);
+				size_type	i = 0;
+
+				openGap(index, count);
+				try
+				{
+					for (; i < count; ++i)
+						new (_ptr() + index + i) value_type(copy);
+				}
+				catch (...)
+				{
+					abandonGap(index, count, i);
+					throw;
+				}
+				_size += count;
+				return (begin() + index);
+			}
+
+			template < class InputIt >
+			iterator	insert(iterator pos, InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				size_type	index = pos - begin();
+				size_type	count = std::distance(first, last);
+				size_type	i = 0;
+
+				checkRoom(count, "static_vector::insert");
+				if (count == 0)
+					return (pos);
+
+				openGap(index, count);
+				try
+				{
+					for (; i < count; ++i, ++first)
+						new (_ptr() + index + i) value_type(*first);
+				}
+				catch (...)
+				{
+					abandonGap(index, count, i);
+					throw;
+				}
+				_size += count;
+				return (begin() + index);
+			}
+
+			iterator	erase(iterator pos)
+			{
+				closeGap(pos - begin(), 1);
+				return (pos);
+			}
+
+			iterator	erase(iterator first, iterator last)
+			{
+				closeGap(first - begin(), last - first);
+				return (first);
+			}
+
+			void	resize(size_type newSize, T value = T())
+			{
+				if (newSize > N)
+					throw std::length_error("static_vector::resize");
+				if (newSize > _size)
+				{
+					for (; _size < newSize; ++_size)
+						new (_ptr() + _size) value_type(value);
+				}
+				else
+				{
+					destroyRange(_ptr() + newSize, _ptr() + _size);
+					_size = newSize;
+				}
+			}
+
+			// Elements cannot change hands between two buffers, so the
+			// common part is swapped and the rest moved across
+			void	swap(static_vector& other)
+			{
+				if (this == &other)
+					return ;
+
+				if (trivial)
+				{
+					static_vector	tmp(other);
+
+					other.copyFrom(*this);
+					copyFrom(tmp);
+					return ;
+				}
+
+				static_vector	&longer = _size > other._size ? *this : other;
+				static_vector	&shorter = _size > other._size ? other : *this;
+				size_type		common = shorter._size;
+
+				for (size_type i = 0; i < common; ++i)
+					std::swap(longer._ptr()[i], shorter._ptr()[i]);
+				shorter.constructRange(shorter._ptr() + common, longer._ptr() + common, longer._size - common);
+				shorter._size = longer._size;
+				longer.destroyRange(longer._ptr() + common, longer._ptr() + longer._size);
+				longer._size = common;
+			}
+	};
+
+	template < class T, std::size_t N >
+	bool	operator==(const static_vector<T,N>& lhs, const static_vector<T,N>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template < class T, std::size_t N >
+	bool	operator!=(const static_vector<T,N>& lhs, const static_vector<T,N>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template < class T, std::size_t N >
+	bool	operator<(const static_vector<T,N>& lhs, const static_vector<T,N>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template < class T, std::size_t N >
+	bool	operator>=(const static_vector<T,N>& lhs, const static_vector<T,N>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template < class T, std::size_t N >
+	bool	operator<=(const static_vector<T,N>& lhs, const static_vector<T,N>& rhs)
+	{
+		return (lhs < rhs || lhs == rhs);
+	}
+
+	template < class T, std::size_t N >
+	bool	operator>(const static_vector<T,N>& lhs, const static_vector<T,N>& rhs)
+	{
+		return (!(lhs <= rhs));
+	}
+
+	template < class T, std::size_t N >
+	void	swap(static_vector<T,N>& lhs, static_vector<T,N>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <cstddef>
+#include <utility>
+
+namespace ft
+{
+
+	// -------------------------------------------------------------------------- //
+	//  Statistics snapshot                                                       //
+	// -------------------------------------------------------------------------- //
+	// Returned by the stats() accessor of every container. Counters that do not
+	// apply to a container (e.g. rotations for a vector) are left to zero.
+	struct container_stats
+	{
+		bool			enabled;			// false when built with the null policy
+		unsigned long	comparisons;		// Comparator calls
+		unsigned long	rotations;			// Left and right rotations
+		unsigned long	recolorings;		// Node color changes during fix-ups
+		unsigned long	reallocations;		// Buffer reallocations
+		unsigned long	relocations;		// Elements copied to another slot
+		unsigned long	bytes_relocated;	// Bytes copied to another slot
+		unsigned long	node_allocations;	// Nodes allocated
+		std::size_t		size;				// Number of elements
+		std::size_t		capacity;			// Number of allocated slots
+		std::size_t		height;				// Height of the tree
+		std::size_t		black_height;		// Black nodes from the root to a leaf
+
+		container_stats():
+			enabled(false),
+			comparisons(0),
+			rotations(0),
+			recolorings(0),
+			reallocations(0),
+			relocations(0),
+			bytes_relocated(0),
+			node_allocations(0),
+			size(0),
+			capacity(0),
+			height(0),
+			black_height(0)
+		{}
+	};
+
+	// -------------------------------------------------------------------------- //
+	//  Memory footprint                                                          //
+	// -------------------------------------------------------------------------- //
+	// Returned by the memory_usage() accessor of every container. The first
+	// three fields add up to the bytes requested from the allocator, which a
+	// counting_allocator can cross-check; what the allocator itself adds
+	// (malloc headers, size class rounding) is not known here. Members living
+	// in the container object, like the end sentinel of a tree, are part of
+	// object.
+	struct memory_usage
+	{
+		std::size_t		payload;			// Bytes of the elements
+		std::size_t		overhead;			// Bytes of nodes, links and maps around them
+		std::size_t		reserved;			// Bytes allocated for elements not constructed yet
+		std::size_t		allocations;		// Live blocks obtained from the allocator
+		std::size_t		object;				// sizeof the container itself
+
+		memory_usage():
+			payload(0),
+			overhead(0),
+			reserved(0),
+			allocations(0),
+			object(0)
+		{}
+
+		std::size_t	heap(void) const
+		{
+			return payload + overhead + reserved;
+		}
+
+		std::size_t	total(void) const
+		{
+			return heap() + object;
+		}
+	};
+
+	// -------------------------------------------------------------------------- //
+	//  Stats policies                                                            //
+	// -------------------------------------------------------------------------- //
+	// Containers inherit from the selected policy, so the empty null_stats
+	// costs neither space (empty base) nor time (inlined no-ops).
+
+	// --- Disabled policy --- //
+	class null_stats
+	{
+		protected:
+			void	countComparisons(unsigned long = 1) const {}
+			void	countRotation(void) const {}
+			void	countRecoloring(void) const {}
+			void	countReallocation(void) const {}
+			void	countRelocations(unsigned long, std::size_t) const {}
+			void	countNodeAllocation(void) const {}
+
+			void	collectStats(container_stats &) const {}
+
+		public:
+			void	reset_stats(void) {}
+	};
+
+	// --- Counting policy --- //
+	class counting_stats
+	{
+		private:
+			// Mutable so that const lookups can still be counted
+			mutable unsigned long	_comparisons;
+			mutable unsigned long	_rotations;
+			mutable unsigned long	_recolorings;
+			mutable unsigned long	_reallocations;
+			mutable unsigned long	_relocations;
+			mutable unsigned long	_bytesRelocated;
+			mutable unsigned long	_nodeAllocations;
+
+		protected:
+			counting_stats():
+				_comparisons(0),
+				_rotations(0),
+				_recolorings(0),
+				_reallocations(0),
+				_relocations(0),
+				_bytesRelocated(0),
+				_nodeAllocations(0)
+			{}
+
+			void	countComparisons(unsigned long n = 1) const	{ _comparisons += n; }
+			void	countRotation(void) const					{ ++_rotations; }
+			void	countRecoloring(void) const					{ ++_recolorings; }
+			void	countReallocation(void) const				{ ++_reallocations; }
+			void	countNodeAllocation(void) const				{ ++_nodeAllocations; }
+
+			void	countRelocations(unsigned long count, std::size_t elementSize) const
+			{
+				_relocations += count;
+				_bytesRelocated += count * elementSize;
+			}
+
+			void	collectStats(container_stats &stats) const
+			{
+				stats.enabled = true;
+				stats.comparisons = _comparisons;
+				stats.rotations = _rotations;
+				stats.recolorings = _recolorings;
+				stats.reallocations = _reallocations;
+				stats.relocations = _relocations;
+				stats.bytes_relocated = _bytesRelocated;
+				stats.node_allocations = _nodeAllocations;
+			}
+
+		public:
+			void	reset_stats(void)
+			{
+				*this = counting_stats();
+			}
+	};
+
+	// Define FT_STATS before including any container to enable the counters.
+#ifdef FT_STATS
+	typedef counting_stats	stats_policy;
+#else
+	typedef null_stats		stats_policy;
+#endif
+
+	// -------------------------------------------------------------------------- //
+	//  Prometheus dumper                                                         //
+	// -------------------------------------------------------------------------- //
+	// Writes snapshots using the Prometheus text exposition format: the HELP
+	// and TYPE lines of every metric family once, then one sample per
+	// container, labelled with container="<name>".
+	struct prometheus_metric
+	{
+		const char	*name;
+		const char	*type;
+		const char	*help;
+	};
+
+	const std::size_t	prometheus_metric_count = 12;
+
+	inline const prometheus_metric	&prometheus_metric_at(std::size_t index)
+	{
+		static const prometheus_metric	metrics[prometheus_metric_count] = {
+			{ "stats_enabled", "gauge", "Whether operation counters are compiled in." },
+			{ "comparisons_total", "counter", "Comparator calls." },
+			{ "rotations_total", "counter", "Tree rotations." },
+			{ "recolorings_total", "counter", "Node recolorings during rebalancing." },
+			{ "reallocations_total", "counter", "Buffer reallocations." },
+			{ "relocations_total", "counter", "Elements copied to another slot." },
+			{ "relocated_bytes_total", "counter", "Bytes copied to another slot." },
+			{ "node_allocations_total", "counter", "Tree nodes allocated." },
+			{ "size", "gauge", "Number of elements." },
+			{ "capacity", "gauge", "Number of allocated element slots." },
+			{ "height", "gauge", "Height of the tree." },
+			{ "black_height", "gauge", "Black height of the tree." }
+		};
+
+		return metrics[index];
+	}
+
+	// Value of the metric at index, in the order above
+	inline unsigned long	prometheus_value(const container_stats &stats, std::size_t index)
+	{
+		switch (index)
+		{
+			case 0:		return stats.enabled;
+			case 1:		return stats.comparisons;
+			case 2:		return stats.rotations;
+			case 3:		return stats.recolorings;
+			case 4:		return stats.reallocations;
+			case 5:		return stats.relocations;
+			case 6:		return stats.bytes_relocated;
+			case 7:		return stats.node_allocations;
+			case 8:		return stats.size;
+			case 9:		return stats.capacity;
+			case 10:	return stats.height;
+			default:	return stats.black_height;
+		}
+	}
+
+	// Snapshots of several containers, [first, last) holding pairs of a
+	// name and a container_stats, e.g. a std::map<std::string,
+	// ft::container_stats>. The range is walked once per metric family.
+	template <class Iterator>
+	void	print_prometheus(std::ostream &os, Iterator first, Iterator last)
+	{
+		for (std::size_t i = 0; i < prometheus_metric_count; ++i)
+		{
+			const prometheus_metric	&metric = prometheus_metric_at(i);
+
+			os << "# HELP ft_container_" << metric.name << " " << metric.help << "\n";
+			os << "# TYPE ft_container_" << metric.name << " " << metric.type << "\n";
+			for (Iterator it = first; it != last; ++it)
+				os << "ft_container_" << metric.name << "{container=\"" << (*it).first << "\"} "
+					<< prometheus_value((*it).second, i) << "\n";
+		}
+	}
+
+	// Snapshot of a single container. Dumps of several containers to the
+	// same output must go through the overload above, which does not repeat
+	// the HELP and TYPE lines.
+	inline void	print_prometheus(std::ostream &os, const container_stats &stats, const std::string &container)
+	{
+		const std::pair<std::string, container_stats>	sample(container, stats);
+
+		print_prometheus(os, &sample, &sample + 1);
+	}
+
+}
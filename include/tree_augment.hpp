@@ -0,0 +1,23 @@
+#pragma once
+
+namespace ft
+{
+
+	// Augmentation policies for ft::RBTree. Every node inherits from
+	// node_base, and update() recomputes the node's extra data from its
+	// element and its children (NULL when missing) whenever the subtree under
+	// the node changes: insertion, removal, rotations, split and join. It is
+	// given the comparator of the tree.
+
+	// No extra data, the empty base costs nothing
+	struct no_augment
+	{
+		struct node_base
+		{};
+
+		template <class Node, class Compare>
+		static void	update(Node &, const Node *, const Node *, const Compare &)
+		{}
+	};
+
+}
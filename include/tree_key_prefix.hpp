@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <functional>
+
+namespace ft
+{
+
+	// Key prefix policies for ft::RBTree. Every node inherits from
+	// node_base, where set() stores prefix() of the node's key when the node
+	// is created. A search computes the prefix of its key once, and
+	// compare() orders it against a node's stored prefix before the keys
+	// themselves are read: a negative result means the key is less, a
+	// positive one greater, and zero that the prefixes tie and the full keys
+	// must be compared. prefix() must thus be non-decreasing in key order.
+
+	// Nothing stored, every comparison goes to the keys
+	struct no_key_prefix
+	{
+		struct node_base
+		{};
+
+		typedef char	prefix_type;
+
+		template <class Key>
+		static prefix_type	prefix(const Key &)
+		{
+			return 0;
+		}
+
+		static void	set(node_base &, prefix_type)
+		{}
+
+		static int	compare(prefix_type, const node_base &)
+		{
+			return 0;
+		}
+	};
+
+	// The first 8 bytes of a string, packed big-endian and padded with
+	// zeros, so that comparing the integers follows the byte order of
+	// std::char_traits<char>. The descent then reads the string buffers,
+	// a cache miss of their own when they are on the heap, only for keys
+	// sharing their first 8 bytes.
+	template <class String>
+	struct string_key_prefix
+	{
+		typedef unsigned long long	prefix_type;
+
+		struct node_base
+		{
+			prefix_type	keyPrefix;
+		};
+
+		static prefix_type	prefix(const String &key)
+		{
+			const std::size_t	length = key.size() < sizeof(prefix_type) ? key.size() : sizeof(prefix_type);
+			prefix_type			packed = 0;
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			std::memcpy(&packed, key.data(), length);
+			return __builtin_bswap64(packed);
+#else
+			for (std::size_t i = 0; i < sizeof(prefix_type); ++i)
+				packed = packed << 8 | (i < length ? static_cast<unsigned char>(key[i]) : 0);
+			return packed;
+#endif
+		}
+
+		static void	set(node_base &node, prefix_type keyPrefix)
+		{
+			node.keyPrefix = keyPrefix;
+		}
+
+		static int	compare(prefix_type keyPrefix, const node_base &node)
+		{
+			return (keyPrefix > node.keyPrefix) - (keyPrefix < node.keyPrefix);
+		}
+	};
+
+	// Policy a tree ordered by Compare gets by default: prefixes are only
+	// stored for strings of char compared with std::less, where they are
+	// known to follow the order.
+	template <class Compare>
+	struct key_prefix_for
+	{
+		typedef no_key_prefix	type;
+	};
+
+	template <class Allocator>
+	struct key_prefix_for<std::less<std::basic_string<char, std::char_traits<char>, Allocator> > >
+	{
+		typedef string_key_prefix<std::basic_string<char, std::char_traits<char>, Allocator> >	type;
+	};
+
+}
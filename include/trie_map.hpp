@@ -0,0 +1,769 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "utility.hpp"
+#include "iterators.hpp"
+#include "trie_node.hpp"
+#include "trie_map_iterator.hpp"
+#include "stats.hpp"
+
+namespace ft
+{
+
+	// --- Trie map class --- //
+	// Ordered map from strings, stored in a path compressed radix trie (see
+	// trie_node) rather than a comparison tree. A lookup reads each byte of
+	// the key once, whatever the number of elements, and a shared prefix is
+	// stored once instead of being compared again at every level. Key must
+	// be a std::basic_string of bytes; iteration follows its order.
+	//
+	// prefix_range() gives the elements whose key starts with a prefix in
+	// O(prefix length) and walks them in order.
+	template <
+		class Key,
+		class T,
+		class Allocator = std::allocator<ft::pair<const Key, T> >
+	>
+	class trie_map: public ft::stats_policy
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef ft::pair<const Key, T>						value_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef Allocator									allocator_type;
+
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+
+		private:
+			typedef ft::trie_node<Key, value_type>								node_type;
+			typedef node_type*													node_pointer;
+			typedef typename Allocator::template rebind<node_type>::other		node_allocator_type;
+			typedef typename Allocator::template rebind<node_pointer>::other	link_allocator_type;
+
+		public:
+			// --- Iterator types --- //
+			typedef trie_map_iterator<node_type, value_type>		iterator;
+			typedef trie_map_iterator<node_type, const value_type>	const_iterator;
+			typedef ft::reverse_iterator<iterator>					reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+		private:
+			// -------------------------------------------------------------- //
+			//  Data members                                                  //
+			// -------------------------------------------------------------- //
+			allocator_type			_alloc;
+			node_allocator_type		_nodeAllocator;
+			link_allocator_type		_linkAllocator;
+			node_pointer			_root;		// Empty label, never removed
+			size_type				_size;
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			// --- Nodes --- //
+			node_pointer	newNode(const key_type &label, node_pointer parent)
+			{
+				node_pointer	node = _nodeAllocator.allocate(1);
+
+				try
+				{
+					_nodeAllocator.construct(node, node_type(label, parent));
+				}
+				catch (...)
+				{
+					_nodeAllocator.deallocate(node, 1);
+					throw;
+				}
+				return node;
+			}
+
+			void	setValue(node_pointer node, const value_type &value)
+			{
+				pointer	slot = _alloc.allocate(1);
+
+				try
+				{
+					_alloc.construct(slot, value);
+				}
+				catch (...)
+				{
+					_alloc.deallocate(slot, 1);
+					throw;
+				}
+				node->value = slot;
+			}
+
+			void	clearValue(node_pointer node)
+			{
+				_alloc.destroy(node->value);
+				_alloc.deallocate(node->value, 1);
+				node->value = NULL;
+			}
+
+			void	destroyNode(node_pointer node)
+			{
+				if (node->value != NULL)
+					clearValue(node);
+				if (node->children != NULL)
+					_linkAllocator.deallocate(node->children, node->capacity);
+				_nodeAllocator.destroy(node);
+				_nodeAllocator.deallocate(node, 1);
+			}
+
+			void	deleteSubtree(node_pointer node)
+			{
+				node_pointer	child = node->firstChild();
+
+				while (child != NULL)
+				{
+					node_pointer	next = node->childAfter(child->byte());
+
+					deleteSubtree(child);
+					child = next;
+				}
+				destroyNode(node);
+			}
+
+			node_pointer	copySubtree(node_pointer source, node_pointer parent)
+			{
+				node_pointer	node = newNode(source->label, parent);
+
+				try
+				{
+					if (source->value != NULL)
+						setValue(node, *source->value);
+					for (node_pointer child = source->firstChild(); child != NULL; child = source->childAfter(child->byte()))
+						attach(node, copySubtree(child, node));
+				}
+				catch (...)
+				{
+					deleteSubtree(node);
+					throw;
+				}
+				return node;
+			}
+
+			// --- Children --- //
+			// Moves the children to an array of capacity slots, switching
+			// between the sorted and the byte indexed forms as needed
+			void	resizeChildren(node_pointer node, unsigned short capacity)
+			{
+				node_pointer	*links = _linkAllocator.allocate(capacity);
+
+				if (capacity == node_type::wide_width)
+				{
+					for (unsigned short b = 0; b < capacity; ++b)
+						links[b] = NULL;
+					for (unsigned short i = 0; i < node->count; ++i)
+						links[node->bytes[i]] = node->children[i];
+				}
+				else if (node->wide())
+				{
+					unsigned short	i = 0;
+
+					for (unsigned short b = 0; b < node_type::wide_width; ++b)
+					{
+						if (node->children[b] == NULL)
+							continue ;
+						links[i] = node->children[b];
+						node->bytes[i++] = static_cast<unsigned char>(b);
+					}
+				}
+				else
+				{
+					for (unsigned short i = 0; i < node->count; ++i)
+						links[i] = node->children[i];
+				}
+				if (node->children != NULL)
+					_linkAllocator.deallocate(node->children, node->capacity);
+				node->children = links;
+				node->capacity = capacity;
+			}
+
+			void	attach(node_pointer parent, node_pointer child)
+			{
+				unsigned char	b = child->byte();
+
+				if (parent->count == parent->capacity)
+				{
+					if (parent->capacity == 0)
+						resizeChildren(parent, 2);
+					else if (parent->capacity == node_type::small_width)
+						resizeChildren(parent, node_type::wide_width);
+					else
+						resizeChildren(parent, parent->capacity * 2);
+				}
+				if (parent->wide())
+					parent->children[b] = child;
+				else
+				{
+					unsigned short	i = parent->slot(b);
+
+					for (unsigned short j = parent->count; j > i; --j)
+					{
+						parent->bytes[j] = parent->bytes[j - 1];
+						parent->children[j] = parent->children[j - 1];
+					}
+					parent->bytes[i] = b;
+					parent->children[i] = child;
+				}
+				++parent->count;
+			}
+
+			// A wide node goes back to the sorted form once half of that
+			// would be enough, so that alternating inserts and erases do not
+			// switch it back and forth
+			void	detach(node_pointer parent, unsigned char b)
+			{
+				--parent->count;
+				if (parent->wide())
+				{
+					parent->children[b] = NULL;
+					if (parent->count <= node_type::small_width / 2)
+						resizeChildren(parent, node_type::small_width);
+					return ;
+				}
+
+				unsigned short	i = parent->slot(b);
+
+				for (; i < parent->count; ++i)
+				{
+					parent->bytes[i] = parent->bytes[i + 1];
+					parent->children[i] = parent->children[i + 1];
+				}
+				if (parent->count == 0)
+				{
+					_linkAllocator.deallocate(parent->children, parent->capacity);
+					parent->children = NULL;
+					parent->capacity = 0;
+				}
+			}
+
+			// Puts child in the place of its sibling with the same byte
+			void	replace(node_pointer parent, node_pointer child)
+			{
+				unsigned char	b = child->byte();
+
+				if (parent->wide())
+					parent->children[b] = child;
+				else
+					parent->children[parent->slot(b)] = child;
+			}
+
+			// Restores the compression above node once it lost its element or
+			// a child: a node without element disappears when it has no
+			// children, and is merged into its child when it has only one.
+			void	prune(node_pointer node)
+			{
+				while (node != _root && node->value == NULL && node->count == 0)
+				{
+					node_pointer	parent = node->parent;
+
+					detach(parent, node->byte());
+					destroyNode(node);
+					node = parent;
+				}
+				if (node != _root && node->value == NULL && node->count == 1)
+				{
+					node_pointer	child = node->firstChild();
+
+					child->label.insert(0, node->label);
+					child->parent = node->parent;
+					replace(node->parent, child);
+					destroyNode(node);
+				}
+			}
+
+			// --- Search --- //
+			// Number of bytes label shares with key from pos
+			static size_type	commonLength(const key_type &label, const key_type &key, size_type pos)
+			{
+				size_type	i = 0;
+
+				while (i < label.size() && pos + i < key.size() && label[i] == key[pos + i])
+					++i;
+				return i;
+			}
+
+			node_pointer	findNode(const key_type &key) const
+			{
+				node_pointer	node = _root;
+				size_type		pos = 0;
+
+				while (pos < key.size())
+				{
+					node = node->child(static_cast<unsigned char>(key[pos]));
+					if (node == NULL || node->label.size() > key.size() - pos
+						|| key.compare(pos, node->label.size(), node->label) != 0)
+						return NULL;
+					pos += node->label.size();
+				}
+				return node->value != NULL ? node : NULL;
+			}
+
+			// First element whose key is not less than key, NULL if none
+			node_pointer	lowerBoundNode(const key_type &key) const
+			{
+				node_pointer	node = _root;
+				size_type		pos = 0;
+
+				while (pos < key.size())
+				{
+					unsigned char	b = static_cast<unsigned char>(key[pos]);
+					node_pointer	child = node->child(b);
+
+					if (child == NULL)
+					{
+						child = node->childAfter(b);
+						return child != NULL ? node_type::first(child) : node_type::after(node);
+					}
+
+					size_type	common = commonLength(child->label, key, pos);
+
+					if (common < child->label.size())
+					{
+						// key ends inside the label or sorts before it
+						if (pos + common == key.size()
+							|| static_cast<unsigned char>(key[pos + common]) < static_cast<unsigned char>(child->label[common]))
+							return node_type::first(child);
+						return node_type::after(child);
+					}
+					pos += common;
+					node = child;
+				}
+				return node_type::first(node);
+			}
+
+			// Node whose subtree holds exactly the keys starting with prefix,
+			// NULL if there are none
+			node_pointer	prefixNode(const key_type &prefix) const
+			{
+				node_pointer	node = _root;
+				size_type		pos = 0;
+
+				while (pos < prefix.size())
+				{
+					node = node->child(static_cast<unsigned char>(prefix[pos]));
+					if (node == NULL)
+						return NULL;
+
+					size_type	common = commonLength(node->label, prefix, pos);
+
+					if (pos + common == prefix.size())
+						return node;
+					if (common < node->label.size())
+						return NULL;
+					pos += common;
+				}
+				return node;
+			}
+
+			// Node of key, created with the nodes above it if needed, without
+			// an element when new
+			node_pointer	insertNode(const key_type &key)
+			{
+				node_pointer	node = _root;
+				size_type		pos = 0;
+
+				while (pos < key.size())
+				{
+					node_pointer	child = node->child(static_cast<unsigned char>(key[pos]));
+
+					if (child == NULL)
+					{
+						child = newNode(key.substr(pos), node);
+						attach(node, child);
+						return child;
+					}
+
+					size_type	common = commonLength(child->label, key, pos);
+
+					if (common < child->label.size())
+					{
+						// Splits the label where key leaves it
+						node_pointer	middle = newNode(child->label.substr(0, common), node);
+
+						replace(node, middle);
+						child->label.erase(0, common);
+						child->parent = middle;
+						attach(middle, child);
+						if (pos + common == key.size())
+							return middle;
+						try
+						{
+							node = newNode(key.substr(pos + common), middle);
+						}
+						catch (...)
+						{
+							prune(middle);
+							throw;
+						}
+						attach(middle, node);
+						return node;
+					}
+					pos += common;
+					node = child;
+				}
+				return node;
+			}
+
+			iterator	makeIterator(node_pointer node)
+			{
+				return iterator(node, _root);
+			}
+
+			const_iterator	makeIterator(node_pointer node) const
+			{
+				return const_iterator(node, _root);
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors                                                  //
+			// -------------------------------------------------------------- //
+			explicit trie_map(const allocator_type& alloc = allocator_type()):
+				_alloc(alloc),
+				_nodeAllocator(alloc),
+				_linkAllocator(alloc),
+				_root(newNode(key_type(), NULL)),
+				_size(0)
+			{}
+
+			template <class InputIterator>
+			trie_map(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type()):
+				_alloc(alloc),
+				_nodeAllocator(alloc),
+				_linkAllocator(alloc),
+				_root(newNode(key_type(), NULL)),
+				_size(0)
+			{
+				try
+				{
+					insert(first, last);
+				}
+				catch (...)
+				{
+					deleteSubtree(_root);
+					throw;
+				}
+			}
+
+			trie_map(const trie_map& other):
+				_alloc(other._alloc),
+				_nodeAllocator(other._nodeAllocator),
+				_linkAllocator(other._linkAllocator),
+				_root(copySubtree(other._root, NULL)),
+				_size(other._size)
+			{}
+
+			trie_map& operator=(const trie_map& other)
+			{
+				if (this != &other)
+				{
+					trie_map	copy(other);
+
+					swap(copy);
+				}
+				return *this;
+			}
+
+			// --- Destructor --- //
+			~trie_map()
+			{
+				deleteSubtree(_root);
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return _alloc;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Iterators                                                     //
+			// -------------------------------------------------------------- //
+			iterator begin()
+			{
+				return makeIterator(node_type::first(_root));
+			}
+
+			const_iterator begin() const
+			{
+				return makeIterator(node_type::first(_root));
+			}
+
+			iterator end()
+			{
+				return makeIterator(NULL);
+			}
+
+			const_iterator end() const
+			{
+				return makeIterator(NULL);
+			}
+
+			reverse_iterator rbegin()
+			{
+				return reverse_iterator(end());
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return const_reverse_iterator(end());
+			}
+
+			reverse_iterator rend()
+			{
+				return reverse_iterator(begin());
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return const_reverse_iterator(begin());
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Accessors --- //
+			mapped_type& operator[](const key_type& key)
+			{
+				return insert(ft::make_pair(key, mapped_type())).first->second;
+			}
+
+			mapped_type& at(const key_type& key)
+			{
+				node_pointer	node = findNode(key);
+
+				if (node == NULL)
+					throw std::out_of_range("trie_map::at");
+				return node->value->second;
+			}
+
+			const mapped_type&	at(const key_type& key) const
+			{
+				node_pointer	node = findNode(key);
+
+				if (node == NULL)
+					throw std::out_of_range("trie_map::at");
+				return node->value->second;
+			}
+
+			// --- Capacity --- //
+			bool empty() const
+			{
+				return _size == 0;
+			}
+
+			size_type size() const
+			{
+				return _size;
+			}
+
+			size_type max_size() const
+			{
+				return _alloc.max_size();
+			}
+
+			// --- Statistics --- //
+			ft::container_stats	stats() const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = _size;
+				return stats;
+			}
+
+			// Nodes and child arrays are overhead. Labels longer than the
+			// strings' inline buffer hold heap memory of their own, which is
+			// not seen here.
+			ft::memory_usage	memory_usage() const
+			{
+				ft::memory_usage	usage;
+				node_pointer		node = _root;
+
+				usage.payload = _size * sizeof(value_type);
+				usage.allocations = _size;
+				usage.object = sizeof(*this);
+				while (node != NULL)
+				{
+					usage.overhead += sizeof(node_type) + node->capacity * sizeof(node_pointer);
+					usage.allocations += 1 + (node->children != NULL);
+
+					// Preorder walk over every node, with or without element
+					if (node->count != 0)
+						node = node->firstChild();
+					else
+					{
+						while (node != _root && node->parent->childAfter(node->byte()) == NULL)
+							node = node->parent;
+						node = node == _root ? NULL : node->parent->childAfter(node->byte());
+					}
+				}
+				return usage;
+			}
+
+			// --- Modifiers --- //
+			void	clear(void)
+			{
+				trie_map	empty(_alloc);
+
+				swap(empty);
+			}
+
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				node_pointer	node = insertNode(val.first);
+
+				if (node->value != NULL)
+					return ft::make_pair(makeIterator(node), false);
+				try
+				{
+					setValue(node, val);
+				}
+				catch (...)
+				{
+					prune(node);
+					throw;
+				}
+				++_size;
+				return ft::make_pair(makeIterator(node), true);
+			}
+
+			template <class InputIterator>
+			void	insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Iterators to the other elements stay valid: only nodes without
+			// an element are removed or merged
+			void	erase(iterator pos)
+			{
+				node_pointer	node = pos.getNode();
+
+				clearValue(node);
+				--_size;
+				prune(node);
+			}
+
+			size_type	erase(const key_type& key)
+			{
+				node_pointer	node = findNode(key);
+
+				if (node == NULL)
+					return 0;
+				erase(makeIterator(node));
+				return 1;
+			}
+
+			void	erase(iterator first, iterator last)
+			{
+				while (first != last)
+					erase(first++);
+			}
+
+			void	swap(trie_map& other)
+			{
+				std::swap(_alloc, other._alloc);
+				std::swap(_nodeAllocator, other._nodeAllocator);
+				std::swap(_linkAllocator, other._linkAllocator);
+				std::swap(_root, other._root);
+				std::swap(_size, other._size);
+			}
+
+			// --- Lookup --- //
+			// O(key length), whatever the size of the map
+			iterator	find(const key_type& key)
+			{
+				return makeIterator(findNode(key));
+			}
+
+			const_iterator	find(const key_type& key) const
+			{
+				return makeIterator(findNode(key));
+			}
+
+			size_type	count(const key_type& key) const
+			{
+				return findNode(key) != NULL;
+			}
+
+			iterator	lower_bound(const key_type& key)
+			{
+				return makeIterator(lowerBoundNode(key));
+			}
+
+			const_iterator	lower_bound(const key_type& key) const
+			{
+				return makeIterator(lowerBoundNode(key));
+			}
+
+			iterator	upper_bound(const key_type& key)
+			{
+				iterator	bound = lower_bound(key);
+
+				if (bound != end() && bound->first == key)
+					++bound;
+				return bound;
+			}
+
+			const_iterator	upper_bound(const key_type& key) const
+			{
+				const_iterator	bound = lower_bound(key);
+
+				if (bound != end() && bound->first == key)
+					++bound;
+				return bound;
+			}
+
+			ft::pair<iterator, iterator>	equal_range(const key_type& key)
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			// The elements whose key starts with prefix, in order. Found in
+			// O(prefix length): they are the subtree below the prefix.
+			ft::pair<iterator, iterator>	prefix_range(const key_type& prefix)
+			{
+				node_pointer	node = prefixNode(prefix);
+
+				if (node == NULL)
+					return ft::make_pair(lower_bound(prefix), lower_bound(prefix));
+				return ft::make_pair(makeIterator(node_type::first(node)), makeIterator(node_type::after(node)));
+			}
+
+			ft::pair<const_iterator, const_iterator>	prefix_range(const key_type& prefix) const
+			{
+				node_pointer	node = prefixNode(prefix);
+
+				if (node == NULL)
+					return ft::make_pair(lower_bound(prefix), lower_bound(prefix));
+				return ft::make_pair(makeIterator(node_type::first(node)), makeIterator(node_type::after(node)));
+			}
+	};
+
+	template <class Key, class T, class Alloc>
+	void	swap(trie_map<Key, T, Alloc>& lhs, trie_map<Key, T, Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
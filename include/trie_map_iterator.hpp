@@ -0,0 +1,115 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+
+#include "trie_node.hpp"
+
+namespace ft
+{
+
+	// --- Trie map iterator class --- //
+	// Walks the elements of a ft::trie_map in key order, see trie_node. The
+	// root is kept so that end(), a NULL node, can be decremented.
+	template <class Node, class Value>
+	class trie_map_iterator
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef std::bidirectional_iterator_tag		iterator_category;
+			typedef Value								value_type;
+			typedef std::ptrdiff_t						difference_type;
+			typedef Value*								pointer;
+			typedef Value&								reference;
+
+		private:
+			Node	*_node;
+			Node	*_root;
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + assignment                         //
+			// -------------------------------------------------------------- //
+			trie_map_iterator():
+				_node(NULL),
+				_root(NULL)
+			{}
+
+			trie_map_iterator(Node *node, Node *root):
+				_node(node),
+				_root(root)
+			{}
+
+			// --- Conversion to const_iterator --- //
+			operator trie_map_iterator<Node, const Value>() const
+			{
+				return trie_map_iterator<Node, const Value>(_node, _root);
+			}
+
+			Node	*getNode(void) const
+			{
+				return _node;
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return *_node->value;
+			}
+
+			pointer operator->() const
+			{
+				return _node->value;
+			}
+
+			// --- Increment / decrement --- //
+			trie_map_iterator &operator++() // ++it
+			{
+				if (_node != NULL)
+					_node = Node::next(_node);
+				return *this;
+			}
+
+			trie_map_iterator operator++(int) // it++
+			{
+				trie_map_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+
+			trie_map_iterator &operator--() // --it
+			{
+				if (_node == NULL)
+					_node = Node::last(_root);
+				else
+					_node = Node::prev(_node);
+				return *this;
+			}
+
+			trie_map_iterator operator--(int) // it--
+			{
+				trie_map_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			// --- Comparison --- //
+			template <class V>
+			bool operator==(const trie_map_iterator<Node, V> &other) const // it == other
+			{
+				return _node == other.getNode();
+			}
+
+			template <class V>
+			bool operator!=(const trie_map_iterator<Node, V> &other) const // it != other
+			{
+				return _node != other.getNode();
+			}
+	};
+
+}
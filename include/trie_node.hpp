@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ft
+{
+
+	// --- Trie node --- //
+	// Node of the path compressed radix trie behind ft::trie_map. The label
+	// holds the bytes of the edge from the parent, its first byte selecting
+	// this node among its siblings; the key of a node is the concatenation
+	// of the labels from the root, whose label is empty. A node holds an
+	// element when its key was inserted. Every node but the root holds an
+	// element or has two children, so that the paths stay compressed.
+	//
+	// The children adapt to their number: up to small_width, their first
+	// bytes are kept sorted in bytes[], next to the children array, and
+	// scanned; past it, children becomes a table indexed by byte. Bytes are
+	// compared unsigned, which is the order of std::string.
+	template <class Key, class Value>
+	struct trie_node
+	{
+		static const unsigned short	small_width = 16;
+		static const unsigned short	wide_width = 256;
+
+		Key				label;				// Bytes from the parent
+		Value			*value;				// Element with this key, NULL if none
+		trie_node		*parent;
+		trie_node		**children;			// Sorted, or indexed by byte when wide
+		unsigned short	count;				// Number of children
+		unsigned short	capacity;			// Slots in children
+		unsigned char	bytes[small_width];	// First byte of each child when not wide
+
+		trie_node(const Key &label, trie_node *parent):
+			label(label),
+			value(NULL),
+			parent(parent),
+			children(NULL),
+			count(0),
+			capacity(0)
+		{}
+
+		trie_node(const trie_node &other):
+			label(other.label),
+			value(NULL),
+			parent(other.parent),
+			children(NULL),
+			count(0),
+			capacity(0)
+		{}
+
+		unsigned char	byte(void) const
+		{
+			return static_cast<unsigned char>(label[0]);
+		}
+
+		bool	wide(void) const
+		{
+			return capacity == wide_width;
+		}
+
+		// Slot of the first child whose byte is not less than b, in a node
+		// that is not wide
+		unsigned short	slot(unsigned char b) const
+		{
+			unsigned short	i = 0;
+
+			while (i < count && bytes[i] < b)
+				++i;
+			return i;
+		}
+
+		// --- Children --- //
+		trie_node	*child(unsigned char b) const
+		{
+			if (wide())
+				return children[b];
+			for (unsigned short i = 0; i < count; ++i)
+				if (bytes[i] == b)
+					return children[i];
+			return NULL;
+		}
+
+		// First child whose byte is greater than b, from b + 1 when after
+		// is false
+		trie_node	*childAfter(unsigned int b, bool after = true) const
+		{
+			if (after)
+				++b;
+			if (wide())
+			{
+				for (; b < wide_width; ++b)
+					if (children[b] != NULL)
+						return children[b];
+				return NULL;
+			}
+			if (b >= wide_width)
+				return NULL;
+
+			unsigned short	i = slot(static_cast<unsigned char>(b));
+
+			return i < count ? children[i] : NULL;
+		}
+
+		// Last child whose byte is less than b
+		trie_node	*childBefore(unsigned int b) const
+		{
+			if (wide())
+			{
+				while (b-- > 0)
+					if (children[b] != NULL)
+						return children[b];
+				return NULL;
+			}
+
+			unsigned short	i = b < wide_width ? slot(static_cast<unsigned char>(b)) : count;
+
+			return i > 0 ? children[i - 1] : NULL;
+		}
+
+		trie_node	*firstChild(void) const
+		{
+			return count == 0 ? NULL : childAfter(0, false);
+		}
+
+		trie_node	*lastChild(void) const
+		{
+			return count == 0 ? NULL : childBefore(wide_width);
+		}
+
+		// --- In-order walk --- //
+		// A key comes before its extensions, so the order of the keys is a
+		// preorder walk visiting the children by byte.
+
+		// First element of the subtree of node, NULL if it has none
+		static trie_node	*first(trie_node *node)
+		{
+			while (node != NULL && node->value == NULL)
+				node = node->firstChild();
+			return node;
+		}
+
+		// Last element of the subtree of node, NULL if it has none
+		static trie_node	*last(trie_node *node)
+		{
+			while (node != NULL && node->count != 0)
+				node = node->lastChild();
+			return node != NULL && node->value != NULL ? node : NULL;
+		}
+
+		// First element after the subtree of node, NULL if none
+		static trie_node	*after(trie_node *node)
+		{
+			for (; node->parent != NULL; node = node->parent)
+			{
+				trie_node	*sibling = node->parent->childAfter(node->byte());
+
+				if (sibling != NULL)
+					return first(sibling);
+			}
+			return NULL;
+		}
+
+		static trie_node	*next(trie_node *node)
+		{
+			if (node->count != 0)
+				return first(node->firstChild());
+			return after(node);
+		}
+
+		static trie_node	*prev(trie_node *node)
+		{
+			for (; node->parent != NULL; node = node->parent)
+			{
+				trie_node	*sibling = node->parent->childBefore(node->byte());
+
+				if (sibling != NULL)
+					return last(sibling);
+				if (node->parent->value != NULL)
+					return node->parent;
+			}
+			return NULL;
+		}
+	};
+
+}
@@ -4,4 +4,6 @@
 #include "enable_if.hpp"
 #include "pair.hpp"
 #include "lexicographical_compare.hpp"
-#include "equal.hpp"
\ No newline at end of file
+#include "equal.hpp"
+#include "allocator_traits.hpp"
+#include "key_of_value.hpp"
\ No newline at end of file
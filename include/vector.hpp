@@ -7,13 +7,14 @@
 #include "iterators.hpp"
 #include "vector_iterator.hpp"
 #include "utility.hpp"
+#include "stats.hpp"
 
 namespace ft
 {
 
 	// --- Vector class --- //
 	template < class T, class Allocator = std::allocator<T> >
-	class vector
+	class vector: public ft::stats_policy
 	{
 		public:
 			// -------------------------------------------------------------- //
@@ -39,6 +40,8 @@ namespace ft
 			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
 
 		private:
+			typedef ft::allocator_traits<Allocator>			alloc_traits;
+
 			// -------------------------------------------------------------- //
 			//  Member variables                                              //
 			// -------------------------------------------------------------- //
@@ -60,9 +63,20 @@ namespace ft
 				if (_size + n > _capacity)
 					reallocation(_size + n);
 
-				// Move the elements to the right
+				// Move the elements to the right, slots past the end are raw
+				// memory and must be constructed rather than assigned
+				countRelocations(_size - index, sizeof(value_type));
 				for (size_type i = _size; i > index && i > 0; i--)
-					_ptr[i + n - 1] = _ptr[i - 1];
+				{
+					if (i + n - 1 >= _size)
+						_alloc.construct(_ptr + i + n - 1, _ptr[i - 1]);
+					else
+						_ptr[i + n - 1] = _ptr[i - 1];
+				}
+
+				// Leave the gap unconstructed, the callers construct into it
+				for (size_type i = index; i < index + n && i < _size; i++)
+					_alloc.destroy(_ptr + i);
 
 				// Update the size
 				_size += n;
@@ -75,9 +89,11 @@ namespace ft
 
 				size_type index = pos - _ptr;
 
-				// Move the elements to the left
-				for (size_type i = index; i < _size; i++)
+				// Move the elements to the left, then destroy the n last ones
+				for (size_type i = index; i + n < _size; i++)
 					_ptr[i] = _ptr[i + n];
+				for (size_type i = _size - n; i < _size; i++)
+					_alloc.destroy(_ptr + i);
 
 				// Update the size
 				_size -= n;
@@ -135,7 +151,7 @@ namespace ft
 
 			// --- Copy constructor --- //
 			vector(const vector &other):
-				_alloc(other._alloc),
+				_alloc(alloc_traits::select_on_container_copy_construction(other._alloc)),
 				_size(other._size),
 				_capacity(other._capacity),
 				_ptr(_alloc.allocate(other._capacity))
@@ -154,21 +170,57 @@ namespace ft
 			// -------------------------------------------------------------- //
 			//  Member functions                                              //
 			// -------------------------------------------------------------- //
-			vector	&operator=(const vector& lhs)
+			// The current buffer is reused whenever it is large enough: live
+			// elements are assigned over, only the difference in size is
+			// constructed or destroyed.
+			vector	&operator=(const vector& other)
 			{
-				// Destroy the current vector
-				clear();
-				_alloc.deallocate(_ptr, _capacity);
+				if (this == &other)
+					return (*this);
 
-				// Copy the new vector
-				_alloc = lhs._alloc;
-				_size = lhs._size;
-				_capacity = lhs._capacity;
+				if (alloc_traits::propagate_on_container_copy_assignment)
+				{
+					// The buffer must go back to the allocator it came from
+					if (!(_alloc == other._alloc))
+						clear();
+					_alloc = other._alloc;
+				}
 
-				// Copy the elements
-				_ptr = _alloc.allocate(_capacity);
-				for (size_type i = 0; i < _size; ++i)
-					_alloc.construct(_ptr + i, lhs._ptr[i]);
+				if (other._size > _capacity)
+				{
+					pointer	new_start = _alloc.allocate(other._size);
+					size_type	i = 0;
+
+					try
+					{
+						for (; i < other._size; ++i)
+							_alloc.construct(new_start + i, other._ptr[i]);
+					}
+					catch (...)
+					{
+						while (i > 0)
+							_alloc.destroy(new_start + --i);
+						_alloc.deallocate(new_start, other._size);
+						throw;
+					}
+					clear();
+					countReallocation();
+					_ptr = new_start;
+					_capacity = other._size;
+				}
+				else if (other._size > _size)
+				{
+					std::copy(other._ptr, other._ptr + _size, _ptr);
+					for (size_type i = _size; i < other._size; ++i)
+						_alloc.construct(_ptr + i, other._ptr[i]);
+				}
+				else
+				{
+					std::copy(other._ptr, other._ptr + other._size, _ptr);
+					for (size_type i = other._size; i < _size; ++i)
+						_alloc.destroy(_ptr + i);
+				}
+				_size = other._size;
 				return (*this);
 			}
 
@@ -314,6 +366,8 @@ namespace ft
 					throw std::length_error("vector::reserve");
 					
 				pointer	new_start = _alloc.allocate(new_cap);
+				countReallocation();
+				countRelocations(_size, sizeof(value_type));
 				for (size_type i = 0; i < _size; ++i)
 				{
 					_alloc.construct(new_start + i, _ptr[i]);
@@ -334,6 +388,30 @@ namespace ft
 				return (_size == 0);
 			}
 
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS.
+			ft::container_stats	stats(void) const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = _capacity;
+				return (stats);
+			}
+
+			// Heap bytes held by the buffer, see ft::memory_usage
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+
+				usage.payload = _size * sizeof(value_type);
+				usage.reserved = (_capacity - _size) * sizeof(value_type);
+				usage.allocations = (_capacity != 0);
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
 			// --- Modifiers --- //
 			void	clear(void)
 			{
@@ -364,19 +442,21 @@ namespace ft
 			iterator	insert(iterator pos, const value_type& value)
 			{
 				difference_type	offset = pos - begin();
+				value_type		copy(value);	// value may be one of the elements
 
 				move_right(pos, 1);
-				_alloc.construct(_ptr + offset, value);
+				_alloc.construct(_ptr + offset, copy);
 				return (begin() + offset);
 			}
 
 			iterator	insert(iterator pos, size_type count, const value_type& value)
 			{
 				difference_type	offset = pos - begin();
+				value_type		copy(value);	// value may be one of the elements
 
 				move_right(pos, count);
 				for (size_type i = 0; i < count; ++i)
-					_alloc.construct(_ptr + offset + i, value);
+					_alloc.construct(_ptr + offset + i, copy);
 				return (begin() + offset);
 			}
 
@@ -424,8 +504,23 @@ namespace ft
 				_size = newSize;
 			}
 
+			// Buffers can only be exchanged when each allocator can free the
+			// other's, otherwise the elements are copied across.
 			void	swap(vector& other)
 			{
+				if (this == &other)
+					return ;
+
+				if (alloc_traits::propagate_on_container_swap)
+					std::swap(_alloc, other._alloc);
+				else if (!(_alloc == other._alloc))
+				{
+					vector	tmp(other.begin(), other.end(), _alloc);
+
+					other = *this;
+					*this = tmp;
+					return ;
+				}
 				std::swap(_ptr, other._ptr);
 				std::swap(_size, other._size);
 				std::swap(_capacity, other._capacity);
@@ -477,3 +572,6 @@ namespace ft
 	}
 
 }
+
+// Packed specialization for bool
+#include "vector_bool.hpp"
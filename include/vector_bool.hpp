@@ -0,0 +1,670 @@
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#include "vector.hpp"
+#include "vector_bool_iterator.hpp"
+
+namespace ft
+{
+
+	// --- Word helpers --- //
+	inline std::size_t	popcount(bit_word word)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return (__builtin_popcountl(word));
+#else
+		std::size_t	count = 0;
+
+		for (; word != 0; word &= word - 1)
+			++count;
+		return (count);
+#endif
+	}
+
+	// Index of the lowest set bit, word must not be 0
+	inline std::size_t	count_trailing_zeros(bit_word word)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return (__builtin_ctzl(word));
+#else
+		std::size_t	count = 0;
+
+		for (; (word & 1) == 0; word >>= 1)
+			++count;
+		return (count);
+#endif
+	}
+
+	// --- Vector<bool> class --- //
+	// Packs the flags into words, one bit each. Bits past size() are always
+	// zero, so that counting and comparisons work on whole words. Elements
+	// are reached through bit_reference proxies: there is no data() and no
+	// bool* into the vector.
+	template < class Allocator >
+	class vector<bool, Allocator>: public ft::stats_policy
+	{
+		public:
+			// -------------------------------------------------------------- //
+			//  Member types                                                  //
+			// -------------------------------------------------------------- //
+			typedef bool									value_type;
+			typedef Allocator								allocator_type;
+			typedef ft::bit_reference						reference;
+			typedef bool									const_reference;
+			typedef std::ptrdiff_t							difference_type;
+			typedef std::size_t								size_type;
+
+			// --- Iterator types --- //
+			typedef ft::bit_iterator						iterator;
+			typedef ft::bit_const_iterator					const_iterator;
+			typedef ft::reverse_iterator<iterator>			reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+			// Returned by find_first() and find_next() when no bit is set
+			static const size_type	npos = static_cast<size_type>(-1);
+
+		private:
+			typedef typename Allocator::template rebind<bit_word>::other	word_allocator_type;
+			typedef ft::allocator_traits<word_allocator_type>				alloc_traits;
+
+			// -------------------------------------------------------------- //
+			//  Member variables                                              //
+			// -------------------------------------------------------------- //
+			word_allocator_type	_alloc;		// Allocator object, for words
+			size_type			_size;		// Number of bits
+			size_type			_words;		// Number of allocated words
+			bit_word			*_ptr;		// First word
+
+			// -------------------------------------------------------------- //
+			//  Private member functions                                      //
+			// -------------------------------------------------------------- //
+			static size_type	wordsFor(size_type bits)
+			{
+				return ((bits + bits_per_word - 1) / bits_per_word);
+			}
+
+			// Mask of the count lowest bits, count being at most a word
+			static bit_word	lowMask(size_type count)
+			{
+				return (count >= bits_per_word ? ~static_cast<bit_word>(0) : (static_cast<bit_word>(1) << count) - 1);
+			}
+
+			// Reads count <= bits_per_word bits starting at index
+			bit_word	getBits(size_type index, size_type count) const
+			{
+				size_type	word = index / bits_per_word;
+				size_type	bit = index % bits_per_word;
+				bit_word	bits = _ptr[word] >> bit;
+
+				if (bit != 0 && bit + count > bits_per_word)
+					bits |= _ptr[word + 1] << (bits_per_word - bit);
+				return (bits & lowMask(count));
+			}
+
+			// Writes the count <= bits_per_word lowest bits of bits at index
+			void	setBits(size_type index, size_type count, bit_word bits)
+			{
+				size_type	word = index / bits_per_word;
+				size_type	bit = index % bits_per_word;
+				bit_word	mask = lowMask(count);
+
+				bits &= mask;
+				_ptr[word] = (_ptr[word] & ~(mask << bit)) | (bits << bit);
+				if (bit != 0 && bit + count > bits_per_word)
+				{
+					size_type	shift = bits_per_word - bit;
+
+					_ptr[word + 1] = (_ptr[word + 1] & ~(mask >> shift)) | (bits >> shift);
+				}
+			}
+
+			// Sets count bits from index to value, a whole word at a time
+			// in the middle
+			void	fillBits(size_type index, size_type count, bool value)
+			{
+				bit_word	word = value ? ~static_cast<bit_word>(0) : 0;
+
+				while (count > 0 && index % bits_per_word != 0)
+				{
+					size_type	chunk = std::min(count, bits_per_word - index % bits_per_word);
+
+					setBits(index, chunk, word);
+					index += chunk;
+					count -= chunk;
+				}
+				std::fill(_ptr + index / bits_per_word, _ptr + (index + count) / bits_per_word, word);
+				index += count / bits_per_word * bits_per_word;
+				count %= bits_per_word;
+				if (count > 0)
+					setBits(index, count, word);
+			}
+
+			// Moves count bits from `from` to `to`, a word at a time, in the
+			// direction that never overwrites bits not read yet
+			void	moveBits(size_type from, size_type to, size_type count)
+			{
+				if (from == to || count == 0)
+					return ;
+				countRelocations(wordsFor(count), sizeof(bit_word));
+				if (to > from)
+				{
+					while (count > 0)
+					{
+						size_type	chunk = std::min(count, bits_per_word);
+
+						count -= chunk;
+						setBits(to + count, chunk, getBits(from + count, chunk));
+					}
+				}
+				else
+				{
+					for (size_type done = 0; done < count; done += bits_per_word)
+					{
+						size_type	chunk = std::min(count - done, bits_per_word);
+
+						setBits(to + done, chunk, getBits(from + done, chunk));
+					}
+				}
+			}
+
+			void	reallocation(size_type new_capacity)
+			{
+				new_capacity = std::max(new_capacity, capacity() * 2);
+				reserve(new_capacity);
+			}
+
+			// Opens a gap of count bits at index, left for the caller to fill
+			void	openGap(size_type index, size_type count)
+			{
+				if (_size + count > capacity())
+					reallocation(_size + count);
+				moveBits(index, index + count, _size - index);
+				_size += count;
+			}
+
+		public:
+			// -------------------------------------------------------------- //
+			//  Constructors/Destructors + copying                            //
+			// -------------------------------------------------------------- //
+			// --- Default constructor --- //
+			vector(void):
+				_alloc(Allocator()),
+				_size(0),
+				_words(0),
+				_ptr(nullptr)
+			{}
+
+			// --- Constructor with allocator --- //
+			explicit vector(const allocator_type &alloc):
+				_alloc(alloc),
+				_size(0),
+				_words(0),
+				_ptr(nullptr)
+			{}
+
+			// --- Constructor with count and value --- //
+			explicit vector( size_type count, const value_type& value = value_type(), const allocator_type& alloc = Allocator() ):
+				_alloc(alloc),
+				_size(0),
+				_words(0),
+				_ptr(nullptr)
+			{
+				assign(count, value);
+			}
+
+			// --- Constructor from iterators --- //
+			template < class InputIt >
+			vector( InputIt first, InputIt last, const allocator_type& alloc = Allocator(), typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0):
+				_alloc(alloc),
+				_size(0),
+				_words(0),
+				_ptr(nullptr)
+			{
+				assign(first, last);
+			}
+
+			// --- Copy constructor --- //
+			vector(const vector &other):
+				_alloc(alloc_traits::select_on_container_copy_construction(other._alloc)),
+				_size(other._size),
+				_words(wordsFor(other._size)),
+				_ptr(_words != 0 ? _alloc.allocate(_words) : nullptr)
+			{
+				std::copy(other._ptr, other._ptr + _words, _ptr);
+			}
+
+			// --- Destructor --- //
+			~vector(void)
+			{
+				if (_ptr != nullptr)
+					_alloc.deallocate(_ptr, _words);
+			}
+
+			// -------------------------------------------------------------- //
+			//  Member functions                                              //
+			// -------------------------------------------------------------- //
+			// Words are copied over the current buffer when it is large
+			// enough
+			vector	&operator=(const vector& other)
+			{
+				size_type	used = wordsFor(other._size);
+
+				if (this == &other)
+					return (*this);
+
+				if (alloc_traits::propagate_on_container_copy_assignment && !(_alloc == other._alloc))
+				{
+					if (_ptr != nullptr)
+						_alloc.deallocate(_ptr, _words);
+					_ptr = nullptr;
+					_words = 0;
+					_size = 0;
+				}
+				if (alloc_traits::propagate_on_container_copy_assignment)
+					_alloc = other._alloc;
+
+				if (used > _words)
+				{
+					bit_word	*new_start = _alloc.allocate(used);
+
+					if (_ptr != nullptr)
+						_alloc.deallocate(_ptr, _words);
+					countReallocation();
+					_ptr = new_start;
+					_words = used;
+				}
+				else if (used < wordsFor(_size))
+					std::fill(_ptr + used, _ptr + wordsFor(_size), 0);
+				std::copy(other._ptr, other._ptr + used, _ptr);
+				_size = other._size;
+				return (*this);
+			}
+
+			void	assign(size_type count, const value_type& value)
+			{
+				size_type	used = wordsFor(_size);
+
+				if (count > capacity())
+					reserve(count);
+				std::fill(_ptr, _ptr + used, 0);
+				_size = count;
+				fillBits(0, count, value);
+			}
+
+			template < class InputIt >
+			void	assign(InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				typename std::iterator_traits<InputIt>::difference_type	n = std::distance(first, last);
+
+				std::fill(_ptr, _ptr + wordsFor(_size), 0);
+				_size = 0;
+				reserve(n);
+				for (; first != last; ++first)
+					push_back(*first);
+			}
+
+			allocator_type	get_allocator(void) const
+			{
+				return (allocator_type(_alloc));
+			}
+
+			// --- Element access --- //
+			reference at(size_type pos)
+			{
+				if (pos >= _size)
+					throw std::out_of_range("vector::at");
+				return ((*this)[pos]);
+			}
+
+			const_reference at(size_type pos) const
+			{
+				if (pos >= _size)
+					throw std::out_of_range("vector::at");
+				return ((*this)[pos]);
+			}
+
+			reference	operator[](size_type pos)
+			{
+				return (reference(_ptr + pos / bits_per_word, static_cast<bit_word>(1) << (pos % bits_per_word)));
+			}
+
+			const_reference	operator[](size_type pos) const
+			{
+				return ((_ptr[pos / bits_per_word] >> (pos % bits_per_word)) & 1);
+			}
+
+			reference	front(void)
+			{
+				return ((*this)[0]);
+			}
+
+			const_reference	front(void) const
+			{
+				return ((*this)[0]);
+			}
+
+			reference	back(void)
+			{
+				return ((*this)[_size - 1]);
+			}
+
+			const_reference	back(void) const
+			{
+				return ((*this)[_size - 1]);
+			}
+
+			// --- Bit queries --- //
+			// Number of set bits, a popcount per word
+			size_type	count(void) const
+			{
+				size_type	total = 0;
+
+				for (size_type i = 0, used = wordsFor(_size); i < used; ++i)
+					total += ft::popcount(_ptr[i]);
+				return (total);
+			}
+
+			// Index of the first set bit, npos if none
+			size_type	find_first(void) const
+			{
+				return (findFrom(0));
+			}
+
+			// Index of the first set bit after pos, npos if none
+			size_type	find_next(size_type pos) const
+			{
+				if (pos >= _size || pos + 1 >= _size)
+					return (npos);
+				return (findFrom(pos + 1));
+			}
+
+		private:
+			// Skips whole zero words, then takes the lowest set bit
+			size_type	findFrom(size_type pos) const
+			{
+				size_type	used = wordsFor(_size);
+				size_type	word = pos / bits_per_word;
+				bit_word	bits;
+
+				if (pos >= _size)
+					return (npos);
+				bits = _ptr[word] & (~static_cast<bit_word>(0) << (pos % bits_per_word));
+				while (bits == 0)
+				{
+					if (++word >= used)
+						return (npos);
+					bits = _ptr[word];
+				}
+				return (word * bits_per_word + ft::count_trailing_zeros(bits));
+			}
+
+		public:
+			// --- Iterators --- //
+			iterator	begin(void)
+			{
+				return (iterator(_ptr, 0));
+			}
+
+			const_iterator	begin(void) const
+			{
+				return (const_iterator(_ptr, 0));
+			}
+
+			iterator	end(void)
+			{
+				return (begin() + _size);
+			}
+
+			const_iterator	end(void) const
+			{
+				return (begin() + _size);
+			}
+
+			reverse_iterator	rbegin(void)
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin(void) const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend(void)
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend(void) const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			// --- Capacity --- //
+			size_type	size(void) const
+			{
+				return (_size);
+			}
+
+			size_type	max_size(void) const
+			{
+				return (_alloc.max_size() * bits_per_word);
+			}
+
+			void	reserve(size_type new_cap)
+			{
+				if (new_cap <= capacity())
+					return ;
+
+				if (new_cap > max_size())
+					throw std::length_error("vector::reserve");
+
+				size_type	words = wordsFor(new_cap);
+				size_type	used = wordsFor(_size);
+				bit_word	*new_start = _alloc.allocate(words);
+
+				countReallocation();
+				countRelocations(used, sizeof(bit_word));
+				std::copy(_ptr, _ptr + used, new_start);
+				std::fill(new_start + used, new_start + words, 0);
+				if (_ptr != nullptr)
+					_alloc.deallocate(_ptr, _words);
+				_ptr = new_start;
+				_words = words;
+			}
+
+			size_type	capacity(void) const
+			{
+				return (_words * bits_per_word);
+			}
+
+			bool	empty(void) const
+			{
+				return (_size == 0);
+			}
+
+			// --- Statistics --- //
+			// Counters are only filled when built with FT_STATS. Sizes are
+			// in bits, relocations in words.
+			ft::container_stats	stats(void) const
+			{
+				ft::container_stats	stats;
+
+				collectStats(stats);
+				stats.size = _size;
+				stats.capacity = capacity();
+				return (stats);
+			}
+
+			// Heap bytes held by the words, see ft::memory_usage. The payload
+			// is the words holding at least one element.
+			ft::memory_usage	memory_usage(void) const
+			{
+				ft::memory_usage	usage;
+
+				usage.payload = wordsFor(_size) * sizeof(bit_word);
+				usage.reserved = (_words - wordsFor(_size)) * sizeof(bit_word);
+				usage.allocations = (_words != 0);
+				usage.object = sizeof(*this);
+				return (usage);
+			}
+
+			// --- Modifiers --- //
+			// Keeps the words, like std::vector
+			void	clear(void)
+			{
+				std::fill(_ptr, _ptr + wordsFor(_size), 0);
+				_size = 0;
+			}
+
+			void	push_back(const value_type& value)
+			{
+				if (_size >= capacity())
+					reallocation(std::max<size_type>(_size + 1, bits_per_word));
+				if (value)
+					_ptr[_size / bits_per_word] |= static_cast<bit_word>(1) << (_size % bits_per_word);
+				++_size;
+			}
+
+			void	pop_back(void)
+			{
+				if (_size == 0)
+					return ;
+				--_size;
+				_ptr[_size / bits_per_word] &= ~(static_cast<bit_word>(1) << (_size % bits_per_word));
+			}
+
+			iterator	insert(iterator pos, const value_type& value)
+			{
+				return (insert(pos, 1, value));
+			}
+
+			iterator	insert(iterator pos, size_type count, const value_type& value)
+			{
+				size_type	offset = pos - begin();
+
+				openGap(offset, count);
+				fillBits(offset, count, value);
+				return (begin() + offset);
+			}
+
+			template < class InputIt >
+			iterator	insert(iterator pos, InputIt first, InputIt last, typename ft::enable_if<!ft::is_integral<InputIt>::value>::type* = 0)
+			{
+				size_type	offset = pos - begin();
+				size_type	count = std::distance(first, last);
+
+				openGap(offset, count);
+				fillBits(offset, count, false);
+				for (size_type i = offset; first != last; ++first, ++i)
+					if (*first)
+						(*this)[i] = true;
+				return (begin() + offset);
+			}
+
+			iterator	erase(iterator pos)
+			{
+				return (erase(pos, pos + 1));
+			}
+
+			iterator	erase(iterator first, iterator last)
+			{
+				size_type	offset = first - begin();
+				size_type	count = last - first;
+
+				moveBits(offset + count, offset, _size - offset - count);
+				fillBits(_size - count, count, false);
+				_size -= count;
+				return (begin() + offset);
+			}
+
+			void	resize(size_type newSize, value_type value = value_type())
+			{
+				if (newSize > _size)
+				{
+					if (newSize > capacity())
+						reallocation(newSize);
+					fillBits(_size, newSize - _size, value);
+				}
+				else
+					fillBits(newSize, _size - newSize, false);
+				_size = newSize;
+			}
+
+			// Flips every bit
+			void	flip(void)
+			{
+				size_type	used = wordsFor(_size);
+
+				for (size_type i = 0; i < used; ++i)
+					_ptr[i] = ~_ptr[i];
+				if (_size % bits_per_word != 0)
+					_ptr[used - 1] &= lowMask(_size % bits_per_word);
+			}
+
+			void	swap(vector& other)
+			{
+				if (this == &other)
+					return ;
+
+				if (alloc_traits::propagate_on_container_swap)
+					std::swap(_alloc, other._alloc);
+				else if (!(_alloc == other._alloc))
+				{
+					vector	tmp(other.begin(), other.end(), allocator_type(_alloc));
+
+					other = *this;
+					*this = tmp;
+					return ;
+				}
+				std::swap(_ptr, other._ptr);
+				std::swap(_size, other._size);
+				std::swap(_words, other._words);
+			}
+
+			// --- Word access --- //
+			// For the comparisons, which work a word at a time
+			const bit_word	*words(void) const
+			{
+				return (_ptr);
+			}
+	};
+
+	template < class Allocator >
+	const typename vector<bool, Allocator>::size_type	vector<bool, Allocator>::npos;
+
+	// Unused bits are zero, so whole words can be compared
+	template < class Alloc >
+	bool	operator==(const vector<bool,Alloc>& lhs, const vector<bool,Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (std::equal(lhs.words(), lhs.words() + (lhs.size() + bits_per_word - 1) / bits_per_word, rhs.words()));
+	}
+
+	// The first differing word gives the first differing bit, the vector
+	// holding a 0 there is the lesser one
+	template < class Alloc >
+	bool	operator<(const vector<bool,Alloc>& lhs, const vector<bool,Alloc>& rhs)
+	{
+		std::size_t	common = std::min(lhs.size(), rhs.size());
+
+		for (std::size_t i = 0; i * bits_per_word < common; ++i)
+		{
+			bit_word	diff = lhs.words()[i] ^ rhs.words()[i];
+			std::size_t	bit;
+
+			if (diff == 0)
+				continue ;
+			bit = i * bits_per_word + ft::count_trailing_zeros(diff);
+			if (bit >= common)
+				break ;
+			return ((rhs.words()[i] >> (bit % bits_per_word)) & 1);
+		}
+		return (lhs.size() < rhs.size());
+	}
+
+}
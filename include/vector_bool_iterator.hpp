@@ -0,0 +1,336 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+
+namespace ft
+{
+
+	// Storage word of the packed ft::vector<bool>
+	typedef unsigned long	bit_word;
+
+	static const std::size_t	bits_per_word = sizeof(bit_word) * 8;
+
+	// --- Bit reference --- //
+	// Stands for a single bit of a word, since a bit cannot be addressed
+	class bit_reference
+	{
+		private:
+			bit_word	*_word;
+			bit_word	_mask;
+
+		public:
+			bit_reference(bit_word *word, bit_word mask):
+				_word(word),
+				_mask(mask)
+			{}
+
+			bit_reference(const bit_reference &other):
+				_word(other._word),
+				_mask(other._mask)
+			{}
+
+			operator bool() const
+			{
+				return ((*_word & _mask) != 0);
+			}
+
+			bool operator~() const
+			{
+				return ((*_word & _mask) == 0);
+			}
+
+			// Writes the bit, it does not rebind the reference
+			bit_reference &operator=(bool value)
+			{
+				if (value)
+					*_word |= _mask;
+				else
+					*_word &= ~_mask;
+				return (*this);
+			}
+
+			bit_reference &operator=(const bit_reference &other)
+			{
+				return (*this = static_cast<bool>(other));
+			}
+
+			void	flip(void)
+			{
+				*_word ^= _mask;
+			}
+	};
+
+	// --- Bit Iterator base --- //
+	// A word and a bit offset in it. Holds the arithmetic and comparisons
+	// shared by iterator and const_iterator, which can then be compared with
+	// each other.
+	class bit_iterator_base
+	{
+		protected:
+			bit_word	*_word;
+			std::size_t	_bit;
+
+			bit_iterator_base(bit_word *word, std::size_t bit):
+				_word(word),
+				_bit(bit)
+			{}
+
+			void	increment(void)
+			{
+				if (++_bit == bits_per_word)
+				{
+					_bit = 0;
+					++_word;
+				}
+			}
+
+			void	decrement(void)
+			{
+				if (_bit-- == 0)
+				{
+					_bit = bits_per_word - 1;
+					--_word;
+				}
+			}
+
+			void	advance(std::ptrdiff_t n)
+			{
+				std::ptrdiff_t	index = static_cast<std::ptrdiff_t>(_bit) + n;
+
+				// Floor division, index may be negative
+				std::ptrdiff_t	words = (index >= 0 ? index : index - static_cast<std::ptrdiff_t>(bits_per_word) + 1)
+					/ static_cast<std::ptrdiff_t>(bits_per_word);
+
+				_word += words;
+				_bit = static_cast<std::size_t>(index - words * static_cast<std::ptrdiff_t>(bits_per_word));
+			}
+
+		public:
+			bit_word	*getWord(void) const
+			{
+				return (_word);
+			}
+
+			std::size_t	getBit(void) const
+			{
+				return (_bit);
+			}
+
+			std::ptrdiff_t operator-(const bit_iterator_base &other) const // it - other
+			{
+				return ((_word - other._word) * static_cast<std::ptrdiff_t>(bits_per_word)
+					+ static_cast<std::ptrdiff_t>(_bit) - static_cast<std::ptrdiff_t>(other._bit));
+			}
+
+			bool operator==(const bit_iterator_base &other) const // it == other
+			{
+				return (_word == other._word && _bit == other._bit);
+			}
+
+			bool operator!=(const bit_iterator_base &other) const // it != other
+			{
+				return (!(*this == other));
+			}
+
+			bool operator<(const bit_iterator_base &other) const // it < other
+			{
+				return (_word < other._word || (_word == other._word && _bit < other._bit));
+			}
+
+			bool operator<=(const bit_iterator_base &other) const // it <= other
+			{
+				return (!(other < *this));
+			}
+
+			bool operator>(const bit_iterator_base &other) const // it > other
+			{
+				return (other < *this);
+			}
+
+			bool operator>=(const bit_iterator_base &other) const // it >= other
+			{
+				return (!(*this < other));
+			}
+	};
+
+	// --- Bit Iterator class --- //
+	class bit_iterator: public bit_iterator_base,
+		public std::iterator<std::random_access_iterator_tag, bool, std::ptrdiff_t, void, bit_reference>
+	{
+		public:
+			typedef std::ptrdiff_t	difference_type;
+			typedef bit_reference	reference;
+
+			bit_iterator():
+				bit_iterator_base(NULL, 0)
+			{}
+
+			bit_iterator(bit_word *word, std::size_t bit):
+				bit_iterator_base(word, bit)
+			{}
+
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return (reference(_word, static_cast<bit_word>(1) << _bit));
+			}
+
+			reference operator[](difference_type n) const
+			{
+				return (*(*this + n));
+			}
+
+			// --- Increment / decrement --- //
+			bit_iterator &operator++() // ++it
+			{
+				increment();
+				return (*this);
+			}
+
+			bit_iterator operator++(int) // it++
+			{
+				bit_iterator tmp(*this);
+				increment();
+				return (tmp);
+			}
+
+			bit_iterator &operator--() // --it
+			{
+				decrement();
+				return (*this);
+			}
+
+			bit_iterator operator--(int) // it--
+			{
+				bit_iterator tmp(*this);
+				decrement();
+				return (tmp);
+			}
+
+			// --- Arithmetic --- //
+			bit_iterator &operator+=(difference_type n) // it += n
+			{
+				advance(n);
+				return (*this);
+			}
+
+			bit_iterator &operator-=(difference_type n) // it -= n
+			{
+				advance(-n);
+				return (*this);
+			}
+
+			bit_iterator operator+(difference_type n) const // it + n
+			{
+				bit_iterator tmp(*this);
+				return (tmp += n);
+			}
+
+			bit_iterator operator-(difference_type n) const // it - n
+			{
+				bit_iterator tmp(*this);
+				return (tmp -= n);
+			}
+
+			using bit_iterator_base::operator-;
+
+			friend bit_iterator operator+(difference_type n, const bit_iterator &it)
+			{
+				return (it + n);
+			}
+	};
+
+	// --- Bit Const Iterator class --- //
+	class bit_const_iterator: public bit_iterator_base,
+		public std::iterator<std::random_access_iterator_tag, bool, std::ptrdiff_t, void, bool>
+	{
+		public:
+			typedef std::ptrdiff_t	difference_type;
+			typedef bool			reference;
+
+			bit_const_iterator():
+				bit_iterator_base(NULL, 0)
+			{}
+
+			bit_const_iterator(const bit_word *word, std::size_t bit):
+				bit_iterator_base(const_cast<bit_word *>(word), bit)
+			{}
+
+			// --- Conversion from iterator --- //
+			bit_const_iterator(const bit_iterator &other):
+				bit_iterator_base(other.getWord(), other.getBit())
+			{}
+
+			// --- Dereference --- //
+			reference operator*() const
+			{
+				return ((*_word >> _bit) & 1);
+			}
+
+			reference operator[](difference_type n) const
+			{
+				return (*(*this + n));
+			}
+
+			// --- Increment / decrement --- //
+			bit_const_iterator &operator++() // ++it
+			{
+				increment();
+				return (*this);
+			}
+
+			bit_const_iterator operator++(int) // it++
+			{
+				bit_const_iterator tmp(*this);
+				increment();
+				return (tmp);
+			}
+
+			bit_const_iterator &operator--() // --it
+			{
+				decrement();
+				return (*this);
+			}
+
+			bit_const_iterator operator--(int) // it--
+			{
+				bit_const_iterator tmp(*this);
+				decrement();
+				return (tmp);
+			}
+
+			// --- Arithmetic --- //
+			bit_const_iterator &operator+=(difference_type n) // it += n
+			{
+				advance(n);
+				return (*this);
+			}
+
+			bit_const_iterator &operator-=(difference_type n) // it -= n
+			{
+				advance(-n);
+				return (*this);
+			}
+
+			bit_const_iterator operator+(difference_type n) const // it + n
+			{
+				bit_const_iterator tmp(*this);
+				return (tmp += n);
+			}
+
+			bit_const_iterator operator-(difference_type n) const // it - n
+			{
+				bit_const_iterator tmp(*this);
+				return (tmp -= n);
+			}
+
+			using bit_iterator_base::operator-;
+
+			friend bit_const_iterator operator+(difference_type n, const bit_const_iterator &it)
+			{
+				return (it + n);
+			}
+	};
+
+}
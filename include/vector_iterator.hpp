@@ -189,7 +189,7 @@ namespace ft
 
 			// --- Difference --- //
 			template <typename IteratorLeft, typename IteratorRight>
-			friend typename IteratorRight::difference_type operator-(const IteratorLeft &left, const IteratorRight &right);
+			friend typename vector_iterator<IteratorRight>::difference_type operator-(const vector_iterator<IteratorLeft> &left, const vector_iterator<IteratorRight> &right);
 
 			// --- Comparison --- //
 			template <class IteratorLeft, class IteratorRight>
@@ -218,10 +218,10 @@ namespace ft
 		return (it + n);
 	}
 
-	// Using IteratorRight::difference_type instead of IteratorLeft::difference_type
-	// to make sure that IteratorLeft and IteratorRight are of the same type
+	// Only for vector iterators, other iterators of the namespace have their
+	// own difference
 	template <class IteratorLeft, class IteratorRight>
-	typename IteratorRight::difference_type operator-(const IteratorLeft &left, const IteratorRight &right)
+	typename vector_iterator<IteratorRight>::difference_type operator-(const vector_iterator<IteratorLeft> &left, const vector_iterator<IteratorRight> &right)
 	{
 		return (left._ptr - right._ptr);
 	}
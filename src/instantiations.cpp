@@ -0,0 +1,5 @@
+// Compiled into the library of `make fast`, see extern_templates.hpp
+#define FT_INSTANTIATING
+#include "extern_templates.hpp"
+
+FT_COMMON_INSTANTIATIONS(template)
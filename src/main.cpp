@@ -1,6 +1,13 @@
 #include "stack.hpp"
 #include "vector.hpp"
+#include "incremental_vector.hpp"
 #include "map.hpp"
+#include "set.hpp"
+#include "frozen_map.hpp"
+#include "memory_resource.hpp"
+#include "parallel.hpp"
+#include "deferred_destroy.hpp"
+#include "static_vector.hpp"
 #include "utility.hpp"
 
 #include <iostream>
@@ -9,8 +16,12 @@
 #include <stack>
 #include <vector>
 #include <chrono>
+#include <cstdlib>
+#include <algorithm>
 #include <string>
 #include <typeinfo>
+#include <stdexcept>
+#include <sstream>
 
 // -------------------------------------------------------------------------- //
 //  Structs                                                                   //
@@ -25,6 +36,41 @@ struct test_integral
 	operator bool() const { return value; }
 };
 
+// Counts its live instances, and makes the copy at which copiesLeft runs
+// out throw
+struct fragile
+{
+	static int	live;
+	static int	copiesLeft;		// Negative for no limit
+
+	int	value;
+
+	fragile(int value = 0): value(value) { ++live; }
+	fragile(const fragile &other): value(other.value) { copied(); ++live; }
+	~fragile() { --live; }
+
+	fragile	&operator=(const fragile &other)
+	{
+		copied();
+		value = other.value;
+		return *this;
+	}
+
+	static void	copied(void)
+	{
+		if (copiesLeft == 0)
+		{
+			copiesLeft = -1;
+			throw std::runtime_error("fragile copy");
+		}
+		if (copiesLeft > 0)
+			--copiesLeft;
+	}
+};
+
+int	fragile::live = 0;
+int	fragile::copiesLeft = -1;
+
 // -------------------------------------------------------------------------- //
 //  Functions                                                                 //
 // -------------------------------------------------------------------------- //
@@ -176,6 +222,557 @@ static void printDiff(std::vector<int> const &v1, std::vector<int> const &v2)
 	std::cout << s2 << std::endl;
 }
 
+// -------------------------------------------------------------------------- //
+//  Behavior tests                                                            //
+// -------------------------------------------------------------------------- //
+// Each check prints its result, main fails if any did not pass
+
+static int	failures = 0;
+
+static void	check(const std::string &name, bool passed)
+{
+	std::cout << emojiBoolean(passed) << " " << name << std::endl;
+	if (!passed)
+		++failures;
+}
+
+template <class Container, class StdContainer>
+static bool	sameElements(const Container &ft, const StdContainer &std)
+{
+	if (ft.size() != std.size())
+		return false;
+	for (size_t i = 0; i < std.size(); ++i)
+		if (!(ft[i] == std[i]))
+			return false;
+	return true;
+}
+
+// Insertions and erasures shifting non-trivial elements, some of them
+// inserting an element of the vector itself
+static void	testVectorInsertErase(void)
+{
+	std::cout << "\e[100;37m Vector insert/erase \e[0m" << std::endl;
+
+	const std::string			a(40, 'a');
+	const std::string			b(40, 'b');
+	ft::vector<std::string>		vec;
+	std::vector<std::string>	ref;
+
+	vec.reserve(8);
+	vec.push_back(a);
+	vec.push_back(b);
+	vec.insert(vec.begin(), vec[0]);
+	ref.push_back(a);
+	ref.push_back(b);
+	ref.insert(ref.begin(), a);
+	check("insert of an element in the gap", sameElements(vec, ref));
+
+	vec.insert(vec.begin() + 1, 3, vec[2]);
+	ref.insert(ref.begin() + 1, 3, b);
+	check("insert of copies of an element moved", sameElements(vec, ref));
+
+	for (size_t i = 0; i < 20; ++i)
+	{
+		vec.insert(vec.begin() + i % vec.size(), vec.back());
+		ref.insert(ref.begin() + i % ref.size(), ref.back());
+	}
+	check("insert while reallocating", sameElements(vec, ref));
+
+	vec.erase(vec.begin() + 2, vec.begin() + 9);
+	ref.erase(ref.begin() + 2, ref.begin() + 9);
+	vec.erase(vec.begin());
+	ref.erase(ref.begin());
+	vec.erase(vec.end() - 1);
+	ref.erase(ref.end() - 1);
+	check("erase", sameElements(vec, ref));
+	std::cout << std::endl;
+}
+
+// Insertions of an element of the vector itself, in the middle of a
+// migration that frees it with the old buffer
+static void	testIncrementalVectorInsert(void)
+{
+	std::cout << "\e[100;37m Incremental vector insert \e[0m" << std::endl;
+
+	ft::incremental_vector<std::string>	vec;
+	std::vector<std::string>			ref;
+
+	for (size_t i = 0; i < 9; ++i)
+	{
+		vec.push_back(std::string(40, 'a' + i));
+		ref.push_back(std::string(40, 'a' + i));
+	}
+	vec.insert(vec.begin(), 2, vec[3]);
+	ref.insert(ref.begin(), 2, ref[3]);
+	check("insert of copies of an element during a migration", sameElements(vec, ref));
+
+	vec.insert(vec.begin() + 1, vec[5]);
+	ref.insert(ref.begin() + 1, std::string(ref[5]));
+	check("insert of an element moved", sameElements(vec, ref));
+
+	for (size_t i = 0; i < 6; ++i)
+	{
+		vec.push_back(vec[i]);
+		ref.push_back(std::string(ref[i]));
+	}
+
+	std::vector<std::string>	range(ref.begin() + 4, ref.begin() + 9);
+
+	vec.insert(vec.begin() + 2, vec.begin() + 4, vec.begin() + 9);
+	ref.insert(ref.begin() + 2, range.begin(), range.end());
+	check("insert of a range of its own elements", sameElements(vec, ref));
+	std::cout << std::endl;
+}
+
+// A copy of a container on an arena is made on the default resource, as
+// polymorphic_allocator selects, for trees as for vectors
+static void	testTreeCopyResource(void)
+{
+	typedef ft::pmr::polymorphic_allocator<ft::pair<const int, int> >	allocator_type;
+	typedef ft::map<int, int, std::less<int>, allocator_type>		pmr_map;
+	typedef ft::pmr::polymorphic_allocator<int>						set_allocator_type;
+	typedef ft::set<int, std::less<int>, set_allocator_type>		pmr_set;
+
+	std::cout << "\e[100;37m Tree copy resource \e[0m" << std::endl;
+
+	ft::pmr::monotonic_buffer_resource	arena;
+	ft::pmr::memory_resource			*fallback = ft::pmr::get_default_resource();
+	pmr_map								map((std::less<int>()), allocator_type(&arena));
+	pmr_set								set((std::less<int>()), set_allocator_type(&arena));
+
+	for (int i = 0; i < 10; ++i)
+	{
+		map.insert(ft::make_pair(i, i));
+		set.insert(i);
+	}
+
+	pmr_map	mapCopy(map);
+	pmr_set	setCopy(set);
+
+	check("map copy on the default resource", mapCopy.get_allocator().resource() == fallback && mapCopy.size() == 10);
+	check("set copy on the default resource", setCopy.get_allocator().resource() == fallback && setCopy.size() == 10);
+
+	pmr_map	assigned((std::less<int>()), allocator_type(&arena));
+
+	assigned = mapCopy;
+	check("assignment keeps the resource", assigned.get_allocator().resource() == &arena && assigned.size() == 10);
+	std::cout << std::endl;
+}
+
+// Adds up the values it is given
+struct value_sum
+{
+	long	total;
+
+	value_sum(): total(0) {}
+
+	void	operator()(const ft::pair<const int, int> &element)
+	{
+		total += element.second;
+	}
+};
+
+template <class Functions>
+static long	totalOf(const Functions &functions)
+{
+	long	total = 0;
+
+	for (size_t i = 0; i < functions.size(); ++i)
+		total += functions[i].total;
+	return total;
+}
+
+// parallel_for_each over a map, and over its ranges held const or not
+static void	testParallelForEach(void)
+{
+	typedef ft::map<int, int>	map_type;
+
+	std::cout << "\e[100;37m Parallel for_each \e[0m" << std::endl;
+
+	map_type	map;
+
+	for (int i = 0; i < 1000; ++i)
+		map.insert(ft::make_pair(i, i));
+
+	ft::vector<ft::pair<map_type::iterator, map_type::iterator> >		parts = map.partition(10);
+	const ft::vector<ft::pair<map_type::iterator, map_type::iterator> >	&constParts = parts;
+
+	check("whole map", totalOf(ft::parallel_for_each(map, value_sum(), 4)) == 499500);
+	check("ranges", totalOf(ft::parallel_for_each(parts, value_sum(), 4)) == 499500);
+	check("const ranges", totalOf(ft::parallel_for_each(constParts, value_sum(), 4)) == 499500);
+	std::cout << std::endl;
+}
+
+// deferred_destroy hands a pmr vector's buffer over rather than copying
+// its elements into a holder on another resource
+static void	testDeferredDestroy(void)
+{
+	typedef ft::pmr::polymorphic_allocator<int>	allocator_type;
+
+	std::cout << "\e[100;37m Deferred destroy \e[0m" << std::endl;
+
+	ft::pmr::unsynchronized_pool_resource	pool;
+	ft::vector<int, allocator_type>			vec((allocator_type(&pool)));
+
+	for (int i = 0; i < 1000; ++i)
+		vec.push_back(i);
+	ft::deferred_destroy(vec);
+	ft::deferred_flush();
+	check("buffer handed over", vec.empty() && vec.capacity() == 0);
+	check("allocator kept", vec.get_allocator().resource() == &pool);
+	std::cout << std::endl;
+}
+
+// Orders ints up or down, decided at run time
+struct directed_less
+{
+	bool	descending;
+
+	explicit directed_less(bool descending = false): descending(descending) {}
+
+	bool	operator()(int lhs, int rhs) const
+	{
+		return descending ? rhs < lhs : lhs < rhs;
+	}
+};
+
+// Assigning a tree ordered by another comparator takes that comparator
+// with the elements
+static void	testTreeAssignComparator(void)
+{
+	typedef ft::set<int, directed_less>			set_type;
+	typedef ft::map<int, int, directed_less>	map_type;
+
+	std::cout << "\e[100;37m Tree assignment comparator \e[0m" << std::endl;
+
+	set_type	down((directed_less(true)));
+	set_type	up((directed_less(false)));
+	map_type	downMap((directed_less(true)));
+	map_type	upMap((directed_less(false)));
+
+	for (int i = 0; i < 10; ++i)
+	{
+		down.insert(i);
+		up.insert(i);
+		downMap.insert(ft::make_pair(i, i));
+	}
+	up = down;
+	up.insert(100);
+	upMap = downMap;
+
+	bool	ordered = true;
+	int		previous = 101;
+
+	for (set_type::iterator it = up.begin(); it != up.end(); ++it)
+	{
+		ordered = ordered && *it < previous;
+		previous = *it;
+	}
+	check("set lookups after assignment", up.find(3) != up.end() && up.count(7) == 1);
+	check("set insert after assignment", ordered && *up.begin() == 100);
+	check("map lookups after assignment", upMap.find(3) != upMap.end() && upMap.begin()->first == 9);
+	std::cout << std::endl;
+}
+
+// Joining maps whose nodes come from different resources copies the
+// elements, even into an empty map
+static void	testMapJoin(void)
+{
+	typedef ft::pmr::polymorphic_allocator<ft::pair<const int, int> >		allocator_type;
+	typedef ft::map<int, int, std::less<int>, allocator_type>			pmr_map;
+
+	std::cout << "\e[100;37m Map join \e[0m" << std::endl;
+
+	ft::pmr::monotonic_buffer_resource	arena;
+	pmr_map								heap((std::less<int>()), allocator_type(ft::pmr::new_delete_resource()));
+	pmr_map								joined((std::less<int>()), allocator_type(&arena));
+
+	for (int i = 0; i < 100; ++i)
+		heap.insert(ft::make_pair(i, i * i));
+	joined.join(heap);
+	check("join into an empty map of another resource", joined.size() == 100 && heap.empty());
+
+	bool	same = true;
+	int		i = 0;
+
+	for (pmr_map::iterator it = joined.begin(); it != joined.end(); ++it, ++i)
+		same = same && it->first == i && it->second == i * i;
+	check("elements joined in order", same && i == 100);
+	std::cout << std::endl;
+}
+
+// Random bit-level modifications of a vector<bool>, mirrored on
+// std::vector<bool>, with positions crossing the word boundaries
+static void	testVectorBool(void)
+{
+	typedef ft::vector<bool>	bits;
+
+	std::cout << "\e[100;37m Vector<bool> \e[0m" << std::endl;
+
+	bits				a, b;
+	std::vector<bool>	ref;
+
+	for (size_t i = 0; i < 200; ++i)
+		b.push_back(i % 3 == 0);
+	a.reserve(1024);
+	a = b;
+	check("assign into a reserved empty vector", sameElements(a, std::vector<bool>(b.begin(), b.end())));
+
+	a.assign(500, true);
+	a = b;
+	check("assign of fewer words", sameElements(a, std::vector<bool>(b.begin(), b.end())) && a.count() == b.count());
+
+	const char	*names[] = { "push_back/pop_back", "insert", "insert count", "insert range",
+		"erase", "erase range", "resize", "flip", "assign count", "assign range", "copy assignment" };
+	bool		passed[11];
+
+	a.clear();
+	std::fill(passed, passed + 11, true);
+	std::srand(42);
+	for (size_t round = 0; round < 3000; ++round)
+	{
+		int		op = std::rand() % 11;
+		size_t	pos = ref.empty() ? 0 : std::rand() % (ref.size() + 1);
+		size_t	count = std::rand() % 150;
+		bool	value = std::rand() % 2;
+
+		std::vector<bool>	source;
+
+		for (size_t i = 0; i < count; ++i)
+			source.push_back(std::rand() % 2);
+		switch (op)
+		{
+			case 0:
+				if (value && !ref.empty())
+				{
+					a.pop_back();
+					ref.pop_back();
+				}
+				else
+				{
+					a.push_back(value);
+					ref.push_back(value);
+				}
+				break ;
+			case 1:
+				a.insert(a.begin() + pos, value);
+				ref.insert(ref.begin() + pos, value);
+				break ;
+			case 2:
+				a.insert(a.begin() + pos, count, value);
+				ref.insert(ref.begin() + pos, count, value);
+				break ;
+			case 3:
+				a.insert(a.begin() + pos, source.begin(), source.end());
+				ref.insert(ref.begin() + pos, source.begin(), source.end());
+				break ;
+			case 4:
+				if (pos < ref.size())
+				{
+					a.erase(a.begin() + pos);
+					ref.erase(ref.begin() + pos);
+				}
+				break ;
+			case 5:
+				count = std::min(count, ref.size() - pos);
+				a.erase(a.begin() + pos, a.begin() + pos + count);
+				ref.erase(ref.begin() + pos, ref.begin() + pos + count);
+				break ;
+			case 6:
+				a.resize(pos + count, value);
+				ref.resize(pos + count, value);
+				break ;
+			case 7:
+				a.flip();
+				ref.flip();
+				break ;
+			case 8:
+				a.assign(count, value);
+				ref.assign(count, value);
+				break ;
+			case 9:
+				a.assign(source.begin(), source.end());
+				ref.assign(source.begin(), source.end());
+				break ;
+			case 10:
+				b.assign(source.begin(), source.end());
+				b.reserve(std::rand() % 400);
+				a = b;
+				ref = source;
+				break ;
+		}
+		if (!sameElements(a, ref) || a.count() != static_cast<size_t>(std::count(ref.begin(), ref.end(), true)))
+			passed[op] = false;
+	}
+	for (size_t op = 0; op < 11; ++op)
+		check(names[op], passed[op]);
+	std::cout << std::endl;
+}
+
+template <class Vector>
+static bool	holds(const Vector &vec, const int *values, size_t count)
+{
+	if (vec.size() != count)
+		return false;
+	for (size_t i = 0; i < count; ++i)
+		if (vec[i].value != values[i])
+			return false;
+	return true;
+}
+
+// Growing a full static_vector throws and leaves it untouched, and a copy
+// throwing halfway through leaves no element behind
+static void	testStaticVector(void)
+{
+	typedef ft::static_vector<int, 4>		small;
+	typedef ft::static_vector<fragile, 16>	fragiles;
+
+	std::cout << "\e[100;37m Static vector \e[0m" << std::endl;
+
+	const int	values[] = { 1, 2, 3, 4, 5, 6 };
+	small		full(values, values + 4);
+	bool		threw;
+	bool		untouched = true;
+
+	threw = false;
+	try { full.push_back(5); } catch (std::length_error &) { threw = true; }
+	untouched = untouched && threw;
+	threw = false;
+	try { full.insert(full.begin(), 2, 0); } catch (std::length_error &) { threw = true; }
+	untouched = untouched && threw;
+	threw = false;
+	try { full.insert(full.begin() + 1, values, values + 1); } catch (std::length_error &) { threw = true; }
+	untouched = untouched && threw;
+	threw = false;
+	try { full.resize(5); } catch (std::length_error &) { threw = true; }
+	untouched = untouched && threw;
+	threw = false;
+	try { full.assign(values, values + 6); } catch (std::length_error &) { threw = true; }
+	untouched = untouched && threw;
+	check("growing past the capacity throws", untouched);
+	check("a full vector is left untouched", full == small(values, values + 4));
+	check("try_push_back on a full vector", !full.try_push_back(5) && full.size() == 4);
+
+	bool	noLeak = true;
+	bool	rolledBack = true;
+	int		copies;
+
+	for (copies = 0; copies < 12; ++copies)
+	{
+		{
+			fragiles	vec(values, values + 6);
+
+			fragile::copiesLeft = copies;
+			try { vec.insert(vec.begin() + 2, 4, fragile(7)); } catch (std::runtime_error &) {}
+			if (fragile::copiesLeft == -1)
+				rolledBack = rolledBack && holds(vec, values, 6);
+			noLeak = noLeak && fragile::live == static_cast<int>(vec.size());
+			fragile::copiesLeft = -1;
+		}
+		noLeak = noLeak && fragile::live == 0;
+	}
+	check("insert of copies that throws is rolled back", rolledBack);
+
+	const fragile	source[] = { fragile(1), fragile(2), fragile(3), fragile(4) };
+
+	for (copies = 0; copies < 8; ++copies)
+	{
+		{
+			fragiles	vec(values, values + 6);
+
+			fragile::copiesLeft = copies;
+			try { vec.insert(vec.begin() + 3, source, source + 4); } catch (std::runtime_error &) {}
+			if (fragile::copiesLeft == -1)
+				rolledBack = rolledBack && holds(vec, values, 6);
+			fragile::copiesLeft = -1;
+		}
+		{
+			fragiles	vec(values, values + 2);
+
+			fragile::copiesLeft = copies;
+			try
+			{
+				fragiles	copy(source, source + 4);
+			}
+			catch (std::runtime_error &)
+			{}
+			try { vec.assign(source, source + 4); } catch (std::runtime_error &) {}
+			noLeak = noLeak && fragile::live == static_cast<int>(vec.size()) + 4;
+			fragile::copiesLeft = -1;
+		}
+		noLeak = noLeak && fragile::live == 4;
+	}
+	check("insert of a range that throws is rolled back", rolledBack);
+	check("no element leaked nor destroyed twice", noLeak);
+	std::cout << std::endl;
+}
+
+// Frozen maps of bools, whose keys or values used to land in the packed
+// vector<bool>
+static void	testFrozenBool(void)
+{
+	std::cout << "\e[100;37m Frozen map of bools \e[0m" << std::endl;
+
+	ft::map<int, bool>	flags;
+	ft::map<bool, int>	counts;
+
+	for (int i = 0; i < 100; ++i)
+		flags[i] = i % 3 == 0;
+	counts[true] = 1;
+	counts[false] = 2;
+
+	const ft::frozen_map<int, bool>	frozenFlags = flags.freeze();
+	const ft::frozen_map<bool, int>	frozenCounts = counts.freeze();
+	bool							same = frozenFlags.size() == 100;
+	int								i = 0;
+
+	for (ft::frozen_map<int, bool>::const_iterator it = frozenFlags.begin(); it != frozenFlags.end(); ++it, ++i)
+		same = same && (*it).first == i && (*it).second == (i % 3 == 0)
+			&& frozenFlags.at(i) == (i % 3 == 0) && (*frozenFlags.find(i)).second == (i % 3 == 0);
+	check("bool values", same && i == 100);
+	check("bool keys", frozenCounts.at(true) == 1 && frozenCounts.at(false) == 2 && (*frozenCounts.begin()).first == false);
+	std::cout << std::endl;
+}
+
+// Prometheus dump of several containers, whose HELP and TYPE lines used to
+// be written again for every container
+static void	testPrometheusDump(void)
+{
+	std::cout << "\e[100;37m Prometheus dump \e[0m" << std::endl;
+
+	ft::vector<int>			vec(10, 0);
+	ft::map<int, int>		map;
+	std::vector<std::pair<std::string, ft::container_stats> >	samples;
+	std::ostringstream		out;
+
+	for (int i = 0; i < 10; ++i)
+		map[i] = i;
+	samples.push_back(std::make_pair(std::string("vector"), vec.stats()));
+	samples.push_back(std::make_pair(std::string("map"), map.stats()));
+	ft::print_prometheus(out, samples.begin(), samples.end());
+
+	std::istringstream	lines(out.str());
+	std::string			line;
+	int					types = 0;
+	int					sizeTypes = 0;
+	int					sizeSamples = 0;
+	int					samplesCount = 0;
+
+	while (std::getline(lines, line))
+	{
+		if (line.compare(0, 7, "# TYPE ") == 0)
+			++types;
+		else if (line[0] != '#')
+			++samplesCount;
+		sizeTypes += line == "# TYPE ft_container_size gauge";
+		sizeSamples += line == "ft_container_size{container=\"vector\"} 10"
+			|| line == "ft_container_size{container=\"map\"} 10";
+	}
+	check("one TYPE line per metric family", types == static_cast<int>(ft::prometheus_metric_count) && sizeTypes == 1);
+	check("one sample per container", samplesCount == 2 * types && sizeSamples == 2);
+	std::cout << std::endl;
+}
+
 template <class Iterator>
 void	printIterator(std::string name, Iterator it, Iterator ite)
 {
@@ -236,7 +833,7 @@ int main(void)
 	map_type::const_iterator it = constMap.begin();
 	map_type::const_iterator ite = constMap.end();
 
-	it->second = 42;
+	// it->second = 42; does not compile, const_iterator is read-only
 
 	for (; it != ite; it++)
 		std::cout << it->first << " -> " << it->second << std::endl;
@@ -245,6 +842,20 @@ int main(void)
 	std::cout << "\e[100;37m Capacity \e[0m" << std::endl;
 	std::cout << "Size: " << map.size() << std::endl;
 	std::cout << "Empty: " << emojiBoolean(map.empty(), true) << std::endl;
+	std::cout << std::endl;
 
-	return (EXIT_SUCCESS);
+	// --- Behavior tests --- //
+	testVectorInsertErase();
+	testIncrementalVectorInsert();
+	testTreeCopyResource();
+	testParallelForEach();
+	testDeferredDestroy();
+	testTreeAssignComparator();
+	testMapJoin();
+	testVectorBool();
+	testStaticVector();
+	testFrozenBool();
+	testPrometheusDump();
+
+	return (failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 }